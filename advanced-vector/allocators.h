@@ -0,0 +1,459 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+#if defined(__linux__)
+#include <malloc.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Аллокатор поверх malloc/free, умеющий расширять буфер на месте через realloc.
+// Буферы от mmap_threshold байт размещаются отдельными отображениями, которые
+// в Linux растут через mremap без копирования страниц и без удвоения пикового RSS.
+// Vector использует reallocate только для тривиально перемещаемых типов
+template <typename T, size_t MmapThreshold = (size_t(64) << 20)>
+class MallocAllocator {
+    static_assert(alignof(T) <= alignof(std::max_align_t),
+                  "malloc does not guarantee alignment of over-aligned types");
+
+public:
+    using value_type = T;
+    using is_always_equal = std::true_type;
+
+    template <typename U>
+    struct rebind {
+        using other = MallocAllocator<U, MmapThreshold>;
+    };
+
+    static constexpr size_t mmap_threshold = MmapThreshold;
+
+    MallocAllocator() noexcept = default;
+
+    template <typename U>
+    MallocAllocator(const MallocAllocator<U, MmapThreshold>&) noexcept {
+    }
+
+    T* allocate(size_t n);
+    void deallocate(T* buf, size_t n) noexcept;
+
+    // Изменяет размер буфера buf с old_n до new_n элементов, сохраняя содержимое.
+    // При ошибке бросает std::bad_alloc, исходный буфер остаётся нетронутым
+    T* reallocate(T* buf, size_t old_n, size_t new_n);
+
+    // Число элементов, реально помещающихся в блок buf, выделенный под n элементов
+    size_t usable_size(T* buf, size_t n) const noexcept;
+
+private:
+    static size_t Bytes(size_t n);
+    static bool IsMapped(size_t n) noexcept;
+
+    static void* Map(size_t bytes);
+    static void Unmap(void* buf, size_t bytes) noexcept;
+};
+
+template <typename T, size_t ThresholdL, typename U, size_t ThresholdR>
+inline bool operator==(const MallocAllocator<T, ThresholdL>&, const MallocAllocator<U, ThresholdR>&) noexcept {
+    return ThresholdL == ThresholdR;
+}
+
+template <typename T, size_t ThresholdL, typename U, size_t ThresholdR>
+inline bool operator!=(const MallocAllocator<T, ThresholdL>& lhs, const MallocAllocator<U, ThresholdR>& rhs) noexcept {
+    return !(lhs == rhs);
+}
+
+//-------------------------MALLOC_ALLOCATOR---------------------
+template <typename T, size_t MmapThreshold>
+inline T* MallocAllocator<T, MmapThreshold>::allocate(size_t n) {
+    const size_t bytes = Bytes(n);
+    void* buf = IsMapped(n) ? Map(bytes) : std::malloc(bytes);
+
+    if (buf == nullptr) {
+        throw std::bad_alloc();
+    }
+
+    return static_cast<T*>(buf);
+}
+
+template <typename T, size_t MmapThreshold>
+inline void MallocAllocator<T, MmapThreshold>::deallocate(T* buf, size_t n) noexcept {
+    if (IsMapped(n)) {
+        Unmap(buf, Bytes(n));
+    } else {
+        std::free(buf);
+    }
+}
+
+template <typename T, size_t MmapThreshold>
+inline T* MallocAllocator<T, MmapThreshold>::reallocate(T* buf, size_t old_n, size_t new_n) {
+    if (buf == nullptr) {
+        return allocate(new_n);
+    }
+
+    const size_t old_bytes = Bytes(old_n);
+    const size_t new_bytes = Bytes(new_n);
+    void* result = nullptr;
+
+    if (!IsMapped(old_n) && !IsMapped(new_n)) {
+        result = std::realloc(static_cast<void*>(buf), new_bytes);
+    }
+#if defined(__linux__)
+    else if (IsMapped(old_n) && IsMapped(new_n)) {
+        result = mremap(static_cast<void*>(buf), old_bytes, new_bytes, MREMAP_MAYMOVE);
+        result = result != MAP_FAILED ? result : nullptr;
+    }
+#endif
+    else {
+        // Буфер переходит между кучей и отдельным отображением: расширить на месте нельзя
+        result = IsMapped(new_n) ? Map(new_bytes) : std::malloc(new_bytes);
+        if (result != nullptr) {
+            std::memcpy(result, static_cast<const void*>(buf), old_bytes < new_bytes ? old_bytes : new_bytes);
+            deallocate(buf, old_n);
+        }
+    }
+
+    if (result == nullptr) {
+        throw std::bad_alloc();
+    }
+
+    return static_cast<T*>(result);
+}
+
+template <typename T, size_t MmapThreshold>
+inline size_t MallocAllocator<T, MmapThreshold>::usable_size(T* buf, size_t n) const noexcept {
+#if defined(__linux__)
+    if (IsMapped(n)) {
+        const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        return (n * sizeof(T) + page_size - 1) / page_size * page_size / sizeof(T);
+    }
+
+    // Запас блока из кучи не должен переводить его в разряд отображений
+    const size_t usable = malloc_usable_size(static_cast<void*>(buf)) / sizeof(T);
+    const size_t mapped_from = (MmapThreshold + sizeof(T) - 1) / sizeof(T);
+    return usable < mapped_from ? (usable > n ? usable : n) : mapped_from - 1;
+#else
+    (void)buf;
+    return n;
+#endif
+}
+
+template <typename T, size_t MmapThreshold>
+inline size_t MallocAllocator<T, MmapThreshold>::Bytes(size_t n) {
+    if (n > static_cast<size_t>(-1) / sizeof(T)) {
+        throw std::bad_alloc();
+    }
+
+    return n * sizeof(T);
+}
+
+template <typename T, size_t MmapThreshold>
+inline bool MallocAllocator<T, MmapThreshold>::IsMapped(size_t n) noexcept {
+#if defined(__linux__)
+    return n >= (MmapThreshold + sizeof(T) - 1) / sizeof(T);
+#else
+    (void)n;
+    return false;
+#endif
+}
+
+template <typename T, size_t MmapThreshold>
+inline void* MallocAllocator<T, MmapThreshold>::Map(size_t bytes) {
+#if defined(__linux__)
+    void* buf = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    return buf != MAP_FAILED ? buf : nullptr;
+#else
+    return std::malloc(bytes);
+#endif
+}
+
+template <typename T, size_t MmapThreshold>
+inline void MallocAllocator<T, MmapThreshold>::Unmap(void* buf, size_t bytes) noexcept {
+#if defined(__linux__)
+    munmap(buf, bytes);
+#else
+    (void)bytes;
+    std::free(buf);
+#endif
+}
+
+enum class HugePageMode {
+    TRANSPARENT,  // обычное отображение с madvise(MADV_HUGEPAGE)
+    EXPLICIT,     // MAP_HUGETLB из пула hugetlbfs; при нехватке страниц откат к TRANSPARENT
+};
+
+enum class NumaMode {
+    DEFAULT,      // политика процесса
+    BIND,         // страницы только с узлов из маски
+    INTERLEAVE,   // страницы поочерёдно распределяются по узлам из маски
+};
+
+struct NumaPolicy {
+    NumaMode mode = NumaMode::DEFAULT;
+    uint64_t node_mask = 0;  // бит i соответствует узлу NUMA с номером i
+};
+
+// Аллокатор для больших буферов: блоки от Threshold байт размещаются отдельными
+// отображениями, выровненными по 2 МиБ и помеченными для huge pages, и при необходимости
+// привязываются к узлам NUMA. Меньшие блоки выделяются через std::allocator.
+// Привязка к NUMA выполняется по возможности: ошибка mbind не считается ошибкой выделения
+template <typename T, size_t Threshold = (size_t(2) << 20)>
+class HugePageAllocator {
+public:
+    using value_type = T;
+    // Освобождение не зависит от политики, поэтому любой экземпляр освобождает память любого другого
+    using is_always_equal = std::true_type;
+
+    template <typename U>
+    struct rebind {
+        using other = HugePageAllocator<U, Threshold>;
+    };
+
+    static constexpr size_t threshold = Threshold;
+    static constexpr size_t HUGE_PAGE_SIZE = size_t(2) << 20;
+
+    HugePageAllocator() noexcept = default;
+    explicit HugePageAllocator(NumaPolicy numa, HugePageMode mode = HugePageMode::TRANSPARENT) noexcept;
+
+    template <typename U>
+    HugePageAllocator(const HugePageAllocator<U, Threshold>& other) noexcept;
+
+    T* allocate(size_t n);
+    void deallocate(T* buf, size_t n) noexcept;
+
+    // Большие блоки округляются до целого числа huge pages, и весь запас доступен вектору
+    size_t usable_size(T* buf, size_t n) const noexcept;
+
+    NumaPolicy GetNumaPolicy() const noexcept;
+    HugePageMode GetHugePageMode() const noexcept;
+
+private:
+    template <typename U, size_t OtherThreshold>
+    friend class HugePageAllocator;
+
+    NumaPolicy numa_;
+    HugePageMode mode_ = HugePageMode::TRANSPARENT;
+
+    static bool IsMapped(size_t n) noexcept;
+    static size_t MappedBytes(size_t n);
+
+    void* Map(size_t bytes) const;
+    void BindToNodes(void* buf, size_t bytes) const noexcept;
+};
+
+template <typename T, size_t ThresholdL, typename U, size_t ThresholdR>
+inline bool operator==(const HugePageAllocator<T, ThresholdL>&, const HugePageAllocator<U, ThresholdR>&) noexcept {
+    return ThresholdL == ThresholdR;
+}
+
+template <typename T, size_t ThresholdL, typename U, size_t ThresholdR>
+inline bool operator!=(const HugePageAllocator<T, ThresholdL>& lhs, const HugePageAllocator<U, ThresholdR>& rhs) noexcept {
+    return !(lhs == rhs);
+}
+
+//-------------------------HUGE_PAGE_ALLOCATOR---------------------
+template <typename T, size_t Threshold>
+inline HugePageAllocator<T, Threshold>::HugePageAllocator(NumaPolicy numa, HugePageMode mode) noexcept : numa_(numa),
+                                                                                                      mode_(mode) {
+}
+
+template <typename T, size_t Threshold>
+template <typename U>
+inline HugePageAllocator<T, Threshold>::HugePageAllocator(const HugePageAllocator<U, Threshold>& other) noexcept : numa_(other.numa_),
+                                                                                                               mode_(other.mode_) {
+}
+
+template <typename T, size_t Threshold>
+inline T* HugePageAllocator<T, Threshold>::allocate(size_t n) {
+    if (!IsMapped(n)) {
+        return std::allocator<T>().allocate(n);
+    }
+
+    const size_t bytes = MappedBytes(n);
+    void* buf = Map(bytes);
+    BindToNodes(buf, bytes);
+
+    return static_cast<T*>(buf);
+}
+
+template <typename T, size_t Threshold>
+inline void HugePageAllocator<T, Threshold>::deallocate(T* buf, size_t n) noexcept {
+    if (!IsMapped(n)) {
+        std::allocator<T>().deallocate(buf, n);
+        return;
+    }
+
+#if defined(__linux__)
+    munmap(static_cast<void*>(buf), MappedBytes(n));
+#endif
+}
+
+template <typename T, size_t Threshold>
+inline size_t HugePageAllocator<T, Threshold>::usable_size(T* /*buf*/, size_t n) const noexcept {
+    return IsMapped(n) ? MappedBytes(n) / sizeof(T) : n;
+}
+
+template <typename T, size_t Threshold>
+inline NumaPolicy HugePageAllocator<T, Threshold>::GetNumaPolicy() const noexcept {
+    return numa_;
+}
+
+template <typename T, size_t Threshold>
+inline HugePageMode HugePageAllocator<T, Threshold>::GetHugePageMode() const noexcept {
+    return mode_;
+}
+
+template <typename T, size_t Threshold>
+inline bool HugePageAllocator<T, Threshold>::IsMapped(size_t n) noexcept {
+#if defined(__linux__)
+    static_assert(alignof(T) <= HUGE_PAGE_SIZE);
+    return n >= (Threshold + sizeof(T) - 1) / sizeof(T);
+#else
+    (void)n;
+    return false;
+#endif
+}
+
+template <typename T, size_t Threshold>
+inline size_t HugePageAllocator<T, Threshold>::MappedBytes(size_t n) {
+    if (n > (static_cast<size_t>(-1) - HUGE_PAGE_SIZE) / sizeof(T)) {
+        throw std::bad_alloc();
+    }
+
+    return (n * sizeof(T) + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+}
+
+template <typename T, size_t Threshold>
+inline void* HugePageAllocator<T, Threshold>::Map(size_t bytes) const {
+#if defined(__linux__)
+    if (mode_ == HugePageMode::EXPLICIT) {
+        void* buf = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (buf != MAP_FAILED) {
+            return buf;
+        }
+    }
+
+    // Отображение с запасом в одну huge page, из которого вырезается выровненный участок
+    const size_t mapped = bytes + HUGE_PAGE_SIZE;
+    void* raw = mmap(nullptr, mapped, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (raw == MAP_FAILED) {
+        throw std::bad_alloc();
+    }
+
+    const uintptr_t begin = reinterpret_cast<uintptr_t>(raw);
+    const uintptr_t aligned = (begin + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+    if (aligned != begin) {
+        munmap(raw, aligned - begin);
+    }
+    const uintptr_t tail = aligned + bytes;
+    if (tail != begin + mapped) {
+        munmap(reinterpret_cast<void*>(tail), begin + mapped - tail);
+    }
+
+    void* buf = reinterpret_cast<void*>(aligned);
+    madvise(buf, bytes, MADV_HUGEPAGE);
+    return buf;
+#else
+    (void)bytes;
+    throw std::bad_alloc();
+#endif
+}
+
+template <typename T, size_t Threshold>
+inline void HugePageAllocator<T, Threshold>::BindToNodes(void* buf, size_t bytes) const noexcept {
+#if defined(__linux__) && defined(SYS_mbind)
+    // Значения MPOL_BIND и MPOL_INTERLEAVE из <numaif.h>: libnuma для этого не требуется
+    constexpr int MPOL_BIND_MODE = 2;
+    constexpr int MPOL_INTERLEAVE_MODE = 3;
+
+    if (numa_.mode == NumaMode::DEFAULT || numa_.node_mask == 0) {
+        return;
+    }
+
+    const int mode = numa_.mode == NumaMode::BIND ? MPOL_BIND_MODE : MPOL_INTERLEAVE_MODE;
+    const unsigned long node_mask = static_cast<unsigned long>(numa_.node_mask);
+    syscall(SYS_mbind, buf, bytes, mode, &node_mask, sizeof(node_mask) * 8, 0);
+#else
+    (void)buf;
+    (void)bytes;
+#endif
+}
+
+// Размер кэш-линии и ширина регистра AVX-512
+inline constexpr size_t CACHE_LINE_SIZE = 64;
+
+// Выделяет буферы с выравниванием не меньше Alignment и alignof(T) через выровненный
+// operator new. Размер блока округляется вверх до кратного выравниванию, поэтому
+// векторный цикл может читать последний неполный регистр целиком, не выходя за
+// пределы блока, а соседние буферы не делят кэш-линию. Пример: Vector<float, AlignedAllocator<float, 64>>
+template <typename T, size_t Alignment = CACHE_LINE_SIZE>
+class AlignedAllocator {
+    static_assert(Alignment != 0 && (Alignment & (Alignment - 1)) == 0, "alignment must be a power of two");
+
+public:
+    using value_type = T;
+    using is_always_equal = std::true_type;
+
+    template <typename U>
+    struct rebind {
+        using other = AlignedAllocator<U, Alignment>;
+    };
+
+    static constexpr size_t alignment = Alignment > alignof(T) ? Alignment : alignof(T);
+
+    AlignedAllocator() noexcept = default;
+
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {
+    }
+
+    T* allocate(size_t n);
+    void deallocate(T* buf, size_t n) noexcept;
+
+    // Запас до границы выравнивания доступен вектору как ёмкость
+    size_t usable_size(T* buf, size_t n) const noexcept;
+
+private:
+    static size_t Bytes(size_t n);
+};
+
+template <typename T, size_t AlignmentL, typename U, size_t AlignmentR>
+inline bool operator==(const AlignedAllocator<T, AlignmentL>&, const AlignedAllocator<U, AlignmentR>&) noexcept {
+    return AlignmentL == AlignmentR;
+}
+
+template <typename T, size_t AlignmentL, typename U, size_t AlignmentR>
+inline bool operator!=(const AlignedAllocator<T, AlignmentL>& lhs, const AlignedAllocator<U, AlignmentR>& rhs) noexcept {
+    return !(lhs == rhs);
+}
+
+//-------------------------ALIGNED_ALLOCATOR---------------------
+template <typename T, size_t Alignment>
+inline T* AlignedAllocator<T, Alignment>::allocate(size_t n) {
+    return static_cast<T*>(::operator new(Bytes(n), std::align_val_t(alignment)));
+}
+
+template <typename T, size_t Alignment>
+inline void AlignedAllocator<T, Alignment>::deallocate(T* buf, size_t /*n*/) noexcept {
+    ::operator delete(static_cast<void*>(buf), std::align_val_t(alignment));
+}
+
+template <typename T, size_t Alignment>
+inline size_t AlignedAllocator<T, Alignment>::usable_size(T* /*buf*/, size_t n) const noexcept {
+    return Bytes(n) / sizeof(T);
+}
+
+template <typename T, size_t Alignment>
+inline size_t AlignedAllocator<T, Alignment>::Bytes(size_t n) {
+    if (n > (static_cast<size_t>(-1) - alignment) / sizeof(T)) {
+        throw std::bad_alloc();
+    }
+
+    return (n * sizeof(T) + alignment - 1) / alignment * alignment;
+}
@@ -0,0 +1,223 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+
+// Проверяемый режим Vector включается макросом ADVANCED_VECTOR_CHECKED, заданным до
+// подключения заголовков. В нём индексы, Front, Back и PopBack проверяются всегда, а итераторы
+// помнят поколение буфера и обнаруживают использование после перераспределения, выход за
+// границы и смешивание итераторов разных векторов. Без макроса код не меняется: итераторы
+// остаются указателями, а проверки сводятся к assert.
+// Поколение меняется только при смене буфера. Insert, Erase и Clear без перераспределения
+// сдвигают элементы на месте, и итератор за точкой изменения продолжает считаться действительным,
+// пока остаётся в границах: такое устаревание проверяемый режим не обнаруживает.
+// Макрос должен быть одинаковым во всех единицах трансляции программы
+
+#ifdef ADVANCED_VECTOR_CHECKED
+inline constexpr bool CHECKED_MODE = true;
+#else
+inline constexpr bool CHECKED_MODE = false;
+#endif
+
+// Обработчик нарушенной проверки. По умолчанию печатает сообщение и вызывает std::abort.
+// Обработчик может бросить исключение; если он вернёт управление, программа всё равно прервётся
+using CheckFailureHandler = void (*)(const char* message);
+
+namespace checked_detail {
+
+inline void DefaultFailureHandler(const char* message) {
+    std::fprintf(stderr, "advanced-vector check failed: %s\n", message);
+}
+
+inline std::atomic<CheckFailureHandler> failure_handler{&DefaultFailureHandler};
+
+[[noreturn]] inline void Fail(const char* message) {
+    failure_handler.load(std::memory_order_relaxed)(message);
+    std::abort();
+}
+
+// Общее для всех итераторов одного буфера состояние. Владелец увеличивает generation при
+// каждом перераспределении и обнуляет owner при уничтожении; итераторы совместно владеют
+// состоянием, поэтому проверка безопасна и после смерти вектора
+struct IteratorState {
+    const void* owner = nullptr;
+    uint64_t generation = 0;
+};
+
+// Состояние в slot, созданное при первом обращении. Итераторы константного вектора могут
+// запрашиваться из нескольких потоков одновременно, поэтому слот читается и заполняется
+// атомарно: состояние создаёт ровно один поток, остальные получают его же
+inline std::shared_ptr<IteratorState> AcquireState(std::shared_ptr<IteratorState>& slot, const void* owner) {
+    std::shared_ptr<IteratorState> state = std::atomic_load_explicit(&slot, std::memory_order_acquire);
+    if (state != nullptr) {
+        return state;
+    }
+    auto created = std::make_shared<IteratorState>();
+    created->owner = owner;
+    if (std::atomic_compare_exchange_strong_explicit(&slot, &state, created, std::memory_order_acq_rel,
+                                                     std::memory_order_acquire)) {
+        return created;
+    }
+    return state;
+}
+
+}  // namespace checked_detail
+
+// Возвращает прежний обработчик
+inline CheckFailureHandler SetCheckFailureHandler(CheckFailureHandler handler) noexcept {
+    return checked_detail::failure_handler.exchange(handler != nullptr ? handler : &checked_detail::DefaultFailureHandler);
+}
+
+// Итератор проверяемого режима. Container предоставляет AsSpan() с текущими границами
+// элементов; Pointer - T* или const T*
+template <typename Container, typename Pointer>
+class CheckedIterator {
+    using State = checked_detail::IteratorState;
+    using MutablePointer = std::add_pointer_t<std::remove_const_t<std::remove_pointer_t<Pointer>>>;
+
+public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = std::remove_cv_t<std::remove_pointer_t<Pointer>>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = Pointer;
+    using reference = std::remove_pointer_t<Pointer>&;
+
+    CheckedIterator() = default;
+    CheckedIterator(Pointer ptr, std::shared_ptr<State> state) noexcept : ptr_(ptr),
+                                                                         state_(std::move(state)),
+                                                                         generation_(state_->generation) {
+    }
+    // iterator приводится к const_iterator
+    template <typename Other, typename = std::enable_if_t<std::is_same_v<Other, MutablePointer>
+                                                          && !std::is_same_v<Other, Pointer>>>
+    CheckedIterator(const CheckedIterator<Container, Other>& other) noexcept : ptr_(other.ptr_),
+                                                                              state_(other.state_),
+                                                                              generation_(other.generation_) {
+    }
+
+    reference operator*() const {
+        CheckDereferenceable();
+        return *ptr_;
+    }
+    pointer operator->() const {
+        CheckDereferenceable();
+        return ptr_;
+    }
+    reference operator[](difference_type offset) const {
+        return *(*this + offset);
+    }
+
+    CheckedIterator& operator++() {
+        return *this += 1;
+    }
+    CheckedIterator operator++(int) {
+        CheckedIterator copy = *this;
+        *this += 1;
+        return copy;
+    }
+    CheckedIterator& operator--() {
+        return *this -= 1;
+    }
+    CheckedIterator operator--(int) {
+        CheckedIterator copy = *this;
+        *this -= 1;
+        return copy;
+    }
+
+    CheckedIterator& operator+=(difference_type offset) {
+        const auto elements = Owner()->AsSpan();
+        const difference_type position = ptr_ - elements.Data();
+        if (position + offset < 0 || position + offset > static_cast<difference_type>(elements.Size())) {
+            checked_detail::Fail("iterator moved out of vector range");
+        }
+        ptr_ += offset;
+        return *this;
+    }
+    CheckedIterator& operator-=(difference_type offset) {
+        return *this += -offset;
+    }
+    friend CheckedIterator operator+(CheckedIterator it, difference_type offset) {
+        return it += offset;
+    }
+    friend CheckedIterator operator+(difference_type offset, CheckedIterator it) {
+        return it += offset;
+    }
+    friend CheckedIterator operator-(CheckedIterator it, difference_type offset) {
+        return it -= offset;
+    }
+    friend difference_type operator-(const CheckedIterator& lhs, const CheckedIterator& rhs) {
+        CheckComparable(lhs, rhs);
+        return lhs.ptr_ - rhs.ptr_;
+    }
+
+    friend bool operator==(const CheckedIterator& lhs, const CheckedIterator& rhs) {
+        CheckComparable(lhs, rhs);
+        return lhs.ptr_ == rhs.ptr_;
+    }
+    friend bool operator!=(const CheckedIterator& lhs, const CheckedIterator& rhs) {
+        return !(lhs == rhs);
+    }
+    friend bool operator<(const CheckedIterator& lhs, const CheckedIterator& rhs) {
+        CheckComparable(lhs, rhs);
+        return lhs.ptr_ < rhs.ptr_;
+    }
+    friend bool operator>(const CheckedIterator& lhs, const CheckedIterator& rhs) {
+        return rhs < lhs;
+    }
+    friend bool operator<=(const CheckedIterator& lhs, const CheckedIterator& rhs) {
+        return !(rhs < lhs);
+    }
+    friend bool operator>=(const CheckedIterator& lhs, const CheckedIterator& rhs) {
+        return !(lhs < rhs);
+    }
+
+    // Указатель на элемент для самого контейнера: проверяет, что итератор принадлежит owner
+    // и не устарел. Допустимый диапазон позиции зависит от операции, его проверяет вызывающий
+    Pointer Unwrap(const Container* owner) const {
+        if (Owner() != owner) {
+            checked_detail::Fail("iterator belongs to another vector");
+        }
+        return ptr_;
+    }
+
+private:
+    template <typename, typename>
+    friend class CheckedIterator;
+
+    Pointer ptr_ = nullptr;
+    std::shared_ptr<State> state_;
+    uint64_t generation_ = 0;
+
+    // Вектор, которому принадлежит итератор, если итератор ещё действителен
+    const Container* Owner() const {
+        if (state_ == nullptr) {
+            checked_detail::Fail("use of a singular iterator");
+        }
+        if (state_->owner == nullptr) {
+            checked_detail::Fail("iterator used after its vector was destroyed");
+        }
+        if (state_->generation != generation_) {
+            checked_detail::Fail("iterator used after reallocation");
+        }
+        return static_cast<const Container*>(state_->owner);
+    }
+
+    void CheckDereferenceable() const {
+        const auto elements = Owner()->AsSpan();
+        if (ptr_ < elements.begin() || ptr_ >= elements.end()) {
+            checked_detail::Fail("dereference of an out-of-range iterator");
+        }
+    }
+
+    static void CheckComparable(const CheckedIterator& lhs, const CheckedIterator& rhs) {
+        if (lhs.Owner() != rhs.Owner()) {
+            checked_detail::Fail("comparison of iterators from different vectors");
+        }
+    }
+};
@@ -0,0 +1,254 @@
+#pragma once
+
+#include "segments.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Вектор только для добавления, в который несколько потоков пишут без блокировок.
+// EmplaceBack резервирует индекс атомарным fetch_add и строит элемент в сегменте,
+// сегменты никогда не перемещаются, поэтому ссылки на элементы остаются валидными.
+// Size() возвращает длину опубликованного префикса: все элементы с меньшими индексами
+// полностью построены, и их можно читать из любого потока без блокировок.
+// Аллокатор должен допускать одновременные вызовы из разных потоков
+template <typename T, typename Allocator = std::allocator<T>, size_t FirstSegmentSize = 64>
+class ConcurrentVector {
+    using AllocTraits = std::allocator_traits<Allocator>;
+    using Index = SegmentIndex<FirstSegmentSize>;
+
+    static_assert(std::is_nothrow_move_constructible_v<T> || std::is_nothrow_copy_constructible_v<T>,
+                  "elements are constructed after their index is reserved and must not throw");
+
+public:
+    using value_type = T;
+    using allocator_type = Allocator;
+
+    ConcurrentVector() = default;
+    explicit ConcurrentVector(const Allocator& alloc) noexcept;
+    // Все вызовы EmplaceBack должны быть завершены
+    ~ConcurrentVector();
+
+    ConcurrentVector(const ConcurrentVector&) = delete;
+    ConcurrentVector& operator=(const ConcurrentVector&) = delete;
+
+    // Если конструктор T может бросить исключение, элемент сначала строится во временном
+    // объекте и перемещается в сегмент. Если не удалось выделить сегмент, резервированный
+    // индекс остаётся пустым, и опубликованный префикс больше не растёт
+    template <typename... Args>
+    T& EmplaceBack(Args&&... args);
+
+    template <typename Value>
+    void PushBack(Value&& value);
+
+    // index < Size()
+    const T& operator[](size_t index) const noexcept;
+    T& operator[](size_t index) noexcept;
+
+    size_t Size() const noexcept;
+    bool Empty() const noexcept;
+    // Число элементов в выделенных подряд сегментах
+    size_t Capacity() const noexcept;
+
+    // Выделяет сегменты под new_capacity элементов; допускает вызовы из разных потоков
+    void Reserve(size_t new_capacity);
+
+    // Вызывает op для каждого элемента опубликованного префикса, проходя сегменты подряд
+    template <typename Operation>
+    void ForEach(Operation op) const;
+
+    const Allocator& GetAllocator() const noexcept;
+
+private:
+    Allocator alloc_;
+    std::atomic<T*> segments_[Index::MAX_SEGMENTS] = {};
+    // Счётчики меняются разными потоками и разнесены по кэш-линиям
+    alignas(64) std::atomic<size_t> reserved_{0};
+    alignas(64) std::atomic<size_t> size_{0};
+
+    // Сегмент хранит элементы и следом флаги готовности каждого из них
+    static size_t SegmentSlots(size_t segment) noexcept;
+    static std::atomic<bool>* ReadyFlags(T* data, size_t segment) noexcept;
+
+    // Возвращает сегмент, выделяя его при необходимости. Потоки, одновременно выделившие
+    // один сегмент, разрешают гонку через compare_exchange, проигравший освобождает свой
+    T* GetSegment(size_t segment);
+    void DeallocateSegment(T* data, size_t segment) noexcept;
+
+    // Продвигает опубликованный префикс через подряд готовые элементы
+    void Publish() noexcept;
+};
+
+//-------------------------CONCURRENT_VECTOR---------------------
+template <typename T, typename Allocator, size_t FirstSegmentSize>
+inline ConcurrentVector<T, Allocator, FirstSegmentSize>::ConcurrentVector(const Allocator& alloc) noexcept : alloc_(alloc) {
+}
+
+template <typename T, typename Allocator, size_t FirstSegmentSize>
+inline ConcurrentVector<T, Allocator, FirstSegmentSize>::~ConcurrentVector() {
+    for (size_t segment = 0; segment < Index::MAX_SEGMENTS; ++segment) {
+        T* data = segments_[segment].load(std::memory_order_acquire);
+        if (data == nullptr) {
+            continue;
+        }
+
+        const std::atomic<bool>* ready = ReadyFlags(data, segment);
+        for (size_t i = 0; i < Index::SegmentSize(segment); ++i) {
+            if (ready[i].load(std::memory_order_relaxed)) {
+                std::destroy_at(data + i);
+            }
+        }
+        DeallocateSegment(data, segment);
+    }
+}
+
+template <typename T, typename Allocator, size_t FirstSegmentSize>
+template <typename... Args>
+inline T& ConcurrentVector<T, Allocator, FirstSegmentSize>::EmplaceBack(Args&&... args) {
+    if constexpr (std::is_nothrow_constructible_v<T, Args&&...>) {
+        const size_t index = reserved_.fetch_add(1, std::memory_order_relaxed);
+        const size_t segment = Index::Segment(index);
+        const size_t offset = Index::Offset(index, segment);
+
+        T* data = GetSegment(segment);
+        T* slot = new (data + offset) T(std::forward<Args>(args)...);
+        ReadyFlags(data, segment)[offset].store(true, std::memory_order_seq_cst);
+
+        Publish();
+        return *slot;
+    } else if constexpr (std::is_nothrow_move_constructible_v<T>) {
+        return EmplaceBack(T(std::forward<Args>(args)...));
+    } else {
+        const T value(std::forward<Args>(args)...);
+        return EmplaceBack(value);
+    }
+}
+
+template <typename T, typename Allocator, size_t FirstSegmentSize>
+template <typename Value>
+inline void ConcurrentVector<T, Allocator, FirstSegmentSize>::PushBack(Value&& value) {
+    EmplaceBack(std::forward<Value>(value));
+}
+
+template <typename T, typename Allocator, size_t FirstSegmentSize>
+inline const T& ConcurrentVector<T, Allocator, FirstSegmentSize>::operator[](size_t index) const noexcept {
+    return const_cast<ConcurrentVector&>(*this)[index];
+}
+
+template <typename T, typename Allocator, size_t FirstSegmentSize>
+inline T& ConcurrentVector<T, Allocator, FirstSegmentSize>::operator[](size_t index) noexcept {
+    assert(index < Size());
+
+    const size_t segment = Index::Segment(index);
+    return segments_[segment].load(std::memory_order_relaxed)[Index::Offset(index, segment)];
+}
+
+template <typename T, typename Allocator, size_t FirstSegmentSize>
+inline size_t ConcurrentVector<T, Allocator, FirstSegmentSize>::Size() const noexcept {
+    return size_.load(std::memory_order_acquire);
+}
+
+template <typename T, typename Allocator, size_t FirstSegmentSize>
+inline bool ConcurrentVector<T, Allocator, FirstSegmentSize>::Empty() const noexcept {
+    return Size() == 0;
+}
+
+template <typename T, typename Allocator, size_t FirstSegmentSize>
+inline size_t ConcurrentVector<T, Allocator, FirstSegmentSize>::Capacity() const noexcept {
+    size_t segment = 0;
+    while (segment < Index::MAX_SEGMENTS && segments_[segment].load(std::memory_order_acquire) != nullptr) {
+        ++segment;
+    }
+    return Index::SegmentBegin(segment);
+}
+
+template <typename T, typename Allocator, size_t FirstSegmentSize>
+inline void ConcurrentVector<T, Allocator, FirstSegmentSize>::Reserve(size_t new_capacity) {
+    if (new_capacity == 0) {
+        return;
+    }
+
+    const size_t last_segment = Index::Segment(new_capacity - 1);
+    for (size_t segment = 0; segment <= last_segment; ++segment) {
+        GetSegment(segment);
+    }
+}
+
+template <typename T, typename Allocator, size_t FirstSegmentSize>
+template <typename Operation>
+inline void ConcurrentVector<T, Allocator, FirstSegmentSize>::ForEach(Operation op) const {
+    const size_t size = Size();
+
+    for (size_t segment = 0; Index::SegmentBegin(segment) < size; ++segment) {
+        const T* data = segments_[segment].load(std::memory_order_relaxed);
+        const size_t count = std::min(Index::SegmentSize(segment), size - Index::SegmentBegin(segment));
+        for (size_t i = 0; i < count; ++i) {
+            op(data[i]);
+        }
+    }
+}
+
+template <typename T, typename Allocator, size_t FirstSegmentSize>
+inline const Allocator& ConcurrentVector<T, Allocator, FirstSegmentSize>::GetAllocator() const noexcept {
+    return alloc_;
+}
+
+template <typename T, typename Allocator, size_t FirstSegmentSize>
+inline size_t ConcurrentVector<T, Allocator, FirstSegmentSize>::SegmentSlots(size_t segment) noexcept {
+    const size_t size = Index::SegmentSize(segment);
+    return size + (size * sizeof(std::atomic<bool>) + sizeof(T) - 1) / sizeof(T);
+}
+
+template <typename T, typename Allocator, size_t FirstSegmentSize>
+inline std::atomic<bool>* ConcurrentVector<T, Allocator, FirstSegmentSize>::ReadyFlags(T* data, size_t segment) noexcept {
+    return reinterpret_cast<std::atomic<bool>*>(data + Index::SegmentSize(segment));
+}
+
+template <typename T, typename Allocator, size_t FirstSegmentSize>
+inline T* ConcurrentVector<T, Allocator, FirstSegmentSize>::GetSegment(size_t segment) {
+    T* data = segments_[segment].load(std::memory_order_acquire);
+    if (data != nullptr) {
+        return data;
+    }
+
+    T* new_data = AllocTraits::allocate(alloc_, SegmentSlots(segment));
+    std::atomic<bool>* ready = ReadyFlags(new_data, segment);
+    for (size_t i = 0; i < Index::SegmentSize(segment); ++i) {
+        new (ready + i) std::atomic<bool>(false);
+    }
+
+    if (segments_[segment].compare_exchange_strong(data, new_data, std::memory_order_acq_rel, std::memory_order_acquire)) {
+        return new_data;
+    }
+
+    DeallocateSegment(new_data, segment);
+    return data;
+}
+
+template <typename T, typename Allocator, size_t FirstSegmentSize>
+inline void ConcurrentVector<T, Allocator, FirstSegmentSize>::DeallocateSegment(T* data, size_t segment) noexcept {
+    AllocTraits::deallocate(alloc_, data, SegmentSlots(segment));
+}
+
+template <typename T, typename Allocator, size_t FirstSegmentSize>
+inline void ConcurrentVector<T, Allocator, FirstSegmentSize>::Publish() noexcept {
+    // Готовность элемента и длина префикса читаются и пишутся в seq_cst порядке: из двух
+    // потоков, завершивших соседние элементы, хотя бы один увидит готовность другого
+    size_t published = size_.load(std::memory_order_seq_cst);
+    while (true) {
+        const size_t segment = Index::Segment(published);
+        T* data = segments_[segment].load(std::memory_order_acquire);
+        if (data == nullptr || !ReadyFlags(data, segment)[Index::Offset(published, segment)].load(std::memory_order_seq_cst)) {
+            return;
+        }
+
+        if (size_.compare_exchange_weak(published, published + 1, std::memory_order_seq_cst)) {
+            ++published;
+        }
+    }
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+
+// Политика роста определяет ёмкость нового буфера, когда в текущий буфер
+// ёмкостью capacity не помещается required элементов размером element_size байт.
+// Результат обязан быть не меньше required
+
+// Удваивает ёмкость: 1, 2, 4, 8...
+struct DoublingGrowth {
+    static size_t NextCapacity(size_t capacity, size_t required, size_t element_size) noexcept;
+};
+
+// Увеличивает ёмкость в полтора раза: освобождённые ранее блоки могут быть переиспользованы аллокатором
+struct OneAndHalfGrowth {
+    static size_t NextCapacity(size_t capacity, size_t required, size_t element_size) noexcept;
+};
+
+// Первый буфер занимает не меньше MinBytes байт (по умолчанию кэш-линию), дальше действует Base
+template <typename Base = DoublingGrowth, size_t MinBytes = 64>
+struct MinChunkGrowth {
+    static size_t NextCapacity(size_t capacity, size_t required, size_t element_size) noexcept;
+};
+
+// Рост по Base до Threshold байт, после чего буфер увеличивается линейно на StepBytes байт
+template <size_t Threshold, size_t StepBytes = Threshold, typename Base = DoublingGrowth>
+struct CappedGrowth {
+    static size_t NextCapacity(size_t capacity, size_t required, size_t element_size) noexcept;
+};
+
+// Округляет размер буфера, предложенный Base, вверх до класса размеров аллокатора:
+// четыре класса на каждое удвоение для малых блоков и кратность странице для больших
+template <typename Base = DoublingGrowth, size_t PageSize = 4096>
+struct SizeClassGrowth {
+    static size_t NextCapacity(size_t capacity, size_t required, size_t element_size) noexcept;
+};
+
+//-------------------------GROWTH_POLICY---------------------
+inline size_t DoublingGrowth::NextCapacity(size_t capacity, size_t required, size_t /*element_size*/) noexcept {
+    const size_t doubled = capacity > std::numeric_limits<size_t>::max() / 2
+                         ? std::numeric_limits<size_t>::max()
+                         : capacity * 2;
+    return std::max({doubled, required, size_t(1)});
+}
+
+inline size_t OneAndHalfGrowth::NextCapacity(size_t capacity, size_t required, size_t /*element_size*/) noexcept {
+    const size_t grown = capacity > std::numeric_limits<size_t>::max() / 3 * 2
+                       ? std::numeric_limits<size_t>::max()
+                       : capacity + capacity / 2;
+    return std::max({grown, capacity + 1, required});
+}
+
+template <typename Base, size_t MinBytes>
+inline size_t MinChunkGrowth<Base, MinBytes>::NextCapacity(size_t capacity, size_t required, size_t element_size) noexcept {
+    const size_t min_capacity = (MinBytes + element_size - 1) / element_size;
+    return std::max(Base::NextCapacity(capacity, required, element_size), min_capacity);
+}
+
+template <size_t Threshold, size_t StepBytes, typename Base>
+inline size_t CappedGrowth<Threshold, StepBytes, Base>::NextCapacity(size_t capacity, size_t required, size_t element_size) noexcept {
+    static_assert(StepBytes > 0);
+
+    if (capacity * element_size < Threshold) {
+        return std::max(std::min(Base::NextCapacity(capacity, required, element_size), Threshold / element_size),
+                        std::max(required, capacity + 1));
+    }
+
+    const size_t step = std::max(StepBytes / element_size, size_t(1));
+    return std::max(capacity + step, required);
+}
+
+template <typename Base, size_t PageSize>
+inline size_t SizeClassGrowth<Base, PageSize>::NextCapacity(size_t capacity, size_t required, size_t element_size) noexcept {
+    const size_t capacity_hint = Base::NextCapacity(capacity, required, element_size);
+    if (capacity_hint > std::numeric_limits<size_t>::max() / element_size - PageSize) {
+        return capacity_hint;
+    }
+
+    size_t bytes = capacity_hint * element_size;
+    if (bytes >= PageSize) {
+        bytes = (bytes + PageSize - 1) / PageSize * PageSize;
+    } else if (bytes > 16) {
+        // Шаг класса равен четверти ближайшей снизу степени двойки
+        size_t power = 16;
+        while (power * 2 <= bytes) {
+            power *= 2;
+        }
+        const size_t step = power / 4;
+        bytes = (bytes + step - 1) / step * step;
+    } else {
+        bytes = 16;
+    }
+
+    return std::max(bytes / element_size, capacity_hint);
+}
@@ -0,0 +1,380 @@
+#pragma once
+
+#include "vector.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+// Вектор с растянутой во времени реаллокацией. При росте выделяется новый буфер, но
+// элементы переносятся в него не сразу, а порциями за каждый следующий EmplaceBack, поэтому
+// ни одно добавление не стоит O(n). Порция не меньше MigrationStep и рассчитывается по приросту
+// ёмкости так, чтобы перенос закончился до заполнения нового буфера: при удвоении это
+// MigrationStep элементов, при линейном росте на k элементов - old_size / k. Пока идёт перенос, элементы
+// с индексами из [migrated_, old_size_) лежат в старом буфере, а operator[] выбирает
+// нужный буфер по индексу. Элементы лежат подряд, только когда IsMigrating() == false
+template <typename T, typename Allocator = std::allocator<T>, typename GrowthPolicy = DoublingGrowth,
+          size_t MigrationStep = 2>
+class IncrementalVector {
+    static_assert(MigrationStep > 0);
+
+public:
+    using value_type = T;
+    using allocator_type = Allocator;
+
+    IncrementalVector() = default;
+    ~IncrementalVector();
+
+    explicit IncrementalVector(const Allocator& alloc) noexcept;
+
+    IncrementalVector(const IncrementalVector& other);
+    IncrementalVector(IncrementalVector&& other) noexcept;
+
+    IncrementalVector& operator=(const IncrementalVector& other);
+    IncrementalVector& operator=(IncrementalVector&& other) noexcept;
+
+    const T& operator[](size_t index) const noexcept;
+    T& operator[](size_t index) noexcept;
+
+    const T& At(size_t index) const;
+    T& At(size_t index);
+
+    const T& Back() const noexcept;
+    T& Back() noexcept;
+
+    size_t Capacity() const noexcept;
+    size_t Size() const noexcept;
+    bool Empty() const noexcept;
+
+    template <typename Value>
+    void PushBack(Value&& value);
+
+    // Если перенос очередных элементов бросит исключение, новый элемент удаляется,
+    // и вектор остаётся в исходном состоянии
+    template <typename... Args>
+    T& EmplaceBack(Args&&... args);
+
+    void PopBack() noexcept;
+
+    // Старый буфер ещё не освобождён, и часть элементов лежит в нём
+    bool IsMigrating() const noexcept;
+    // Переносит все оставшиеся элементы за O(n), после чего они лежат подряд
+    void FinishMigration();
+
+    // Выделяет буфер сразу, с полным переносом элементов за O(n)
+    void Reserve(size_t new_capacity);
+
+    // Вызывает op для каждого элемента по порядку, проходя непрерывные участки буферов
+    template <typename Operation>
+    void ForEach(Operation op);
+    template <typename Operation>
+    void ForEach(Operation op) const;
+
+    void Swap(IncrementalVector& other) noexcept;
+
+    const Allocator& GetAllocator() const noexcept;
+
+private:
+    RawMemory<T, Allocator> data_;
+    RawMemory<T, Allocator> old_;
+    size_t size_ = 0;
+    // Элементы [migrated_, old_size_) ещё лежат в old_, остальные - в data_ по своим индексам
+    size_t migrated_ = 0;
+    size_t old_size_ = 0;
+    // Элементов, переносимых за одно добавление в текущий буфер
+    size_t migration_step_ = MigrationStep;
+
+    const T* Slot(size_t index) const noexcept;
+    T* Slot(size_t index) noexcept;
+
+    // Переносит до count элементов из old_ в data_ и освобождает old_ по завершении
+    void Migrate(size_t count);
+    void DestroyAll() noexcept;
+};
+
+//-------------------------INCREMENTAL_VECTOR---------------------
+template <typename T, typename Allocator, typename GrowthPolicy, size_t MigrationStep>
+inline IncrementalVector<T, Allocator, GrowthPolicy, MigrationStep>::~IncrementalVector() {
+    DestroyAll();
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, size_t MigrationStep>
+inline IncrementalVector<T, Allocator, GrowthPolicy, MigrationStep>::IncrementalVector(const Allocator& alloc) noexcept : data_(alloc),
+                                                                                                                       old_(alloc) {
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, size_t MigrationStep>
+inline IncrementalVector<T, Allocator, GrowthPolicy, MigrationStep>::IncrementalVector(const IncrementalVector& other)
+    : IncrementalVector(std::allocator_traits<Allocator>::select_on_container_copy_construction(other.GetAllocator())) {
+    RawMemory<T, Allocator> new_data(other.size_, data_.GetAllocator());
+    size_t constructed = 0;
+    try {
+        other.ForEach([&](const T& value) {
+            new (new_data + constructed) T(value);
+            ++constructed;
+        });
+    } catch (...) {
+        std::destroy_n(new_data.GetAddress(), constructed);
+        throw;
+    }
+
+    data_.Swap(new_data);
+    size_ = other.size_;
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, size_t MigrationStep>
+inline IncrementalVector<T, Allocator, GrowthPolicy, MigrationStep>::IncrementalVector(IncrementalVector&& other) noexcept
+    : data_(std::move(other.data_)),
+      old_(std::move(other.old_)),
+      size_(std::exchange(other.size_, 0)),
+      migrated_(std::exchange(other.migrated_, 0)),
+      old_size_(std::exchange(other.old_size_, 0)),
+      migration_step_(std::exchange(other.migration_step_, MigrationStep)) {
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, size_t MigrationStep>
+inline IncrementalVector<T, Allocator, GrowthPolicy, MigrationStep>& IncrementalVector<T, Allocator, GrowthPolicy, MigrationStep>::operator=(const IncrementalVector& other) {
+    if (this != &other) {
+        IncrementalVector copy(other);
+        Swap(copy);
+    }
+    return *this;
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, size_t MigrationStep>
+inline IncrementalVector<T, Allocator, GrowthPolicy, MigrationStep>& IncrementalVector<T, Allocator, GrowthPolicy, MigrationStep>::operator=(IncrementalVector&& other) noexcept {
+    if (this != &other) {
+        IncrementalVector moved(std::move(other));
+        Swap(moved);
+    }
+    return *this;
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, size_t MigrationStep>
+inline const T& IncrementalVector<T, Allocator, GrowthPolicy, MigrationStep>::operator[](size_t index) const noexcept {
+    assert(index < size_);
+    return *Slot(index);
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, size_t MigrationStep>
+inline T& IncrementalVector<T, Allocator, GrowthPolicy, MigrationStep>::operator[](size_t index) noexcept {
+    assert(index < size_);
+    return *Slot(index);
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, size_t MigrationStep>
+inline const T& IncrementalVector<T, Allocator, GrowthPolicy, MigrationStep>::At(size_t index) const {
+    if (index >= size_) {
+        throw std::out_of_range("Index out of range");
+    }
+    return *Slot(index);
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, size_t MigrationStep>
+inline T& IncrementalVector<T, Allocator, GrowthPolicy, MigrationStep>::At(size_t index) {
+    if (index >= size_) {
+        throw std::out_of_range("Index out of range");
+    }
+    return *Slot(index);
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, size_t MigrationStep>
+inline const T& IncrementalVector<T, Allocator, GrowthPolicy, MigrationStep>::Back() const noexcept {
+    assert(size_ != 0);
+    return *Slot(size_ - 1);
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, size_t MigrationStep>
+inline T& IncrementalVector<T, Allocator, GrowthPolicy, MigrationStep>::Back() noexcept {
+    assert(size_ != 0);
+    return *Slot(size_ - 1);
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, size_t MigrationStep>
+inline size_t IncrementalVector<T, Allocator, GrowthPolicy, MigrationStep>::Capacity() const noexcept {
+    return data_.Capacity();
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, size_t MigrationStep>
+inline size_t IncrementalVector<T, Allocator, GrowthPolicy, MigrationStep>::Size() const noexcept {
+    return size_;
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, size_t MigrationStep>
+inline bool IncrementalVector<T, Allocator, GrowthPolicy, MigrationStep>::Empty() const noexcept {
+    return size_ == 0;
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, size_t MigrationStep>
+template <typename Value>
+inline void IncrementalVector<T, Allocator, GrowthPolicy, MigrationStep>::PushBack(Value&& value) {
+    EmplaceBack(std::forward<Value>(value));
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, size_t MigrationStep>
+template <typename... Args>
+inline T& IncrementalVector<T, Allocator, GrowthPolicy, MigrationStep>::EmplaceBack(Args&&... args) {
+    // Перенос при росте возможен, только если он не нарушает строгую гарантию отката
+    constexpr bool migrate_on_growth = IsTriviallyRelocatable<T>::value || std::is_nothrow_move_constructible_v<T>;
+
+    if (size_ == data_.Capacity()) {
+        // Порция переноса рассчитана так, что к заполнению буфера старый уже освобождён. Остаток
+        // бывает только у типов без noexcept-перемещения, когда ёмкость выросла на один элемент
+        FinishMigration();
+
+        const size_t new_capacity = GrowthPolicy::NextCapacity(data_.Capacity(), size_ + 1, sizeof(T));
+        RawMemory<T, Allocator> new_data(new_capacity, data_.GetAllocator());
+        // Аргументы могут ссылаться на элементы вектора, поэтому элемент строится до обмена буферов
+        T* slot = new (new_data + size_) T(std::forward<Args>(args)...);
+
+        old_ = std::move(data_);
+        data_ = std::move(new_data);
+        migrated_ = 0;
+        old_size_ = size_;
+
+        // Добавления, которые успеют перенести элементы до заполнения нового буфера
+        const size_t pushes = new_capacity - size_ - (migrate_on_growth ? 0 : 1);
+        migration_step_ = pushes == 0 ? old_size_ : std::max(MigrationStep, (old_size_ + pushes - 1) / pushes);
+        ++size_;
+
+        if constexpr (migrate_on_growth) {
+            Migrate(migration_step_);
+        }
+        return *slot;
+    }
+
+    T* slot = new (data_ + size_) T(std::forward<Args>(args)...);
+    if (IsMigrating()) {
+        try {
+            Migrate(migration_step_);
+        } catch (...) {
+            std::destroy_at(slot);
+            throw;
+        }
+    }
+
+    ++size_;
+    return *slot;
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, size_t MigrationStep>
+inline void IncrementalVector<T, Allocator, GrowthPolicy, MigrationStep>::PopBack() noexcept {
+    assert(size_ != 0);
+
+    std::destroy_at(Slot(--size_));
+    old_size_ = std::min(old_size_, size_);
+    migrated_ = std::min(migrated_, old_size_);
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, size_t MigrationStep>
+inline bool IncrementalVector<T, Allocator, GrowthPolicy, MigrationStep>::IsMigrating() const noexcept {
+    return old_.GetAddress() != nullptr;
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, size_t MigrationStep>
+inline void IncrementalVector<T, Allocator, GrowthPolicy, MigrationStep>::FinishMigration() {
+    if (IsMigrating()) {
+        Migrate(old_size_ - migrated_);
+    }
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, size_t MigrationStep>
+inline void IncrementalVector<T, Allocator, GrowthPolicy, MigrationStep>::Reserve(size_t new_capacity) {
+    FinishMigration();
+    if (new_capacity <= data_.Capacity()) {
+        return;
+    }
+
+    old_ = RawMemory<T, Allocator>(new_capacity, data_.GetAllocator());
+    old_.Swap(data_);
+    migrated_ = 0;
+    old_size_ = size_;
+    FinishMigration();
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, size_t MigrationStep>
+template <typename Operation>
+inline void IncrementalVector<T, Allocator, GrowthPolicy, MigrationStep>::ForEach(Operation op) {
+    for (size_t i = 0; i < migrated_; ++i) {
+        op(data_[i]);
+    }
+    for (size_t i = migrated_; i < old_size_; ++i) {
+        op(old_[i]);
+    }
+    for (size_t i = old_size_; i < size_; ++i) {
+        op(data_[i]);
+    }
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, size_t MigrationStep>
+template <typename Operation>
+inline void IncrementalVector<T, Allocator, GrowthPolicy, MigrationStep>::ForEach(Operation op) const {
+    for (size_t i = 0; i < migrated_; ++i) {
+        op(data_[i]);
+    }
+    for (size_t i = migrated_; i < old_size_; ++i) {
+        op(old_[i]);
+    }
+    for (size_t i = old_size_; i < size_; ++i) {
+        op(data_[i]);
+    }
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, size_t MigrationStep>
+inline void IncrementalVector<T, Allocator, GrowthPolicy, MigrationStep>::Swap(IncrementalVector& other) noexcept {
+    data_.Swap(other.data_);
+    old_.Swap(other.old_);
+    std::swap(size_, other.size_);
+    std::swap(migrated_, other.migrated_);
+    std::swap(old_size_, other.old_size_);
+    std::swap(migration_step_, other.migration_step_);
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, size_t MigrationStep>
+inline const Allocator& IncrementalVector<T, Allocator, GrowthPolicy, MigrationStep>::GetAllocator() const noexcept {
+    return data_.GetAllocator();
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, size_t MigrationStep>
+inline const T* IncrementalVector<T, Allocator, GrowthPolicy, MigrationStep>::Slot(size_t index) const noexcept {
+    return index >= migrated_ && index < old_size_ ? old_ + index : data_ + index;
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, size_t MigrationStep>
+inline T* IncrementalVector<T, Allocator, GrowthPolicy, MigrationStep>::Slot(size_t index) noexcept {
+    return index >= migrated_ && index < old_size_ ? old_ + index : data_ + index;
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, size_t MigrationStep>
+inline void IncrementalVector<T, Allocator, GrowthPolicy, MigrationStep>::Migrate(size_t count) {
+    count = std::min(count, old_size_ - migrated_);
+
+    if constexpr (IsTriviallyRelocatable<T>::value) {
+        RelocateN(old_ + migrated_, count, data_ + migrated_);
+        migrated_ += count;
+    } else {
+        // Элемент покидает старый буфер только после того, как построен в новом
+        for (size_t end = migrated_ + count; migrated_ < end; ++migrated_) {
+            new (data_ + migrated_) T(std::move_if_noexcept(old_[migrated_]));
+            std::destroy_at(old_ + migrated_);
+        }
+    }
+
+    if (migrated_ == old_size_) {
+        old_.Reset(data_.GetAllocator());
+        migrated_ = 0;
+        old_size_ = 0;
+    }
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, size_t MigrationStep>
+inline void IncrementalVector<T, Allocator, GrowthPolicy, MigrationStep>::DestroyAll() noexcept {
+    ForEach([](T& value) {
+        std::destroy_at(&value);
+    });
+}
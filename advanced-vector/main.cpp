@@ -1,10 +1,44 @@
+#include "allocators.h"
+#include "concurrent_vector.h"
+#include "incremental_vector.h"
+#include "mapped_vector.h"
+#include "parallel_algorithms.h"
+#include "segmented_vector.h"
+#include "serialization.h"
+#include "shared_vector.h"
+#include "simd_algorithms.h"
+#include "small_vector.h"
+#include "soa_vector.h"
+#include "static_vector.h"
+#include "traversal.h"
 #include "vector.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
 #include <iostream>
+#include <iterator>
+#include <list>
+#include <memory_resource>
+#include <numeric>
+#include <random>
+#include <sstream>
 #include <stdexcept>
 #include <string>
+#include <system_error>
+#include <thread>
+#include <utility>
 #include <vector>
 
+#include <fcntl.h>
+#include <unistd.h>
+
 namespace {
 
 // "Магическое" число, используемое для отслеживания живости объекта
@@ -116,8 +150,33 @@ struct Obj {
     static inline int num_move_assigned = 0;
 };
 
+// Владеющий дескриптор: перемещение нетривиально, но объект можно переносить побайтово
+struct Handle {
+    Handle() = default;
+    explicit Handle(int value) : value(new int(value)) {
+    }
+    Handle(Handle&& other) noexcept : value(std::exchange(other.value, nullptr)) {
+        ++num_moved;
+    }
+    Handle& operator=(Handle&& other) noexcept {
+        std::swap(value, other.value);
+        ++num_moved;
+        return *this;
+    }
+    ~Handle() {
+        delete value;
+    }
+
+    int* value = nullptr;
+
+    static inline int num_moved = 0;
+};
+
 }  // namespace
 
+template <>
+struct IsTriviallyRelocatable<Handle> : std::true_type {};
+
 void Test1() {
     Obj::ResetCounters();
     const size_t SIZE = 100500;
@@ -445,7 +504,7 @@ void Test6() {
     {
         Obj::ResetCounters();
         Vector<Obj> v;
-        auto* pos = v.Emplace(v.end(), Obj{1});
+        auto pos = v.Emplace(v.end(), Obj{1});
         assert(v.Size() == 1);
         assert(v.Capacity() >= v.Size());
         assert(&*pos == &v[0]);
@@ -460,7 +519,7 @@ void Test6() {
         Obj::ResetCounters();
         Vector<Obj> v;
         v.Reserve(SIZE);
-        auto* pos = v.Emplace(v.end(), Obj{1});
+        auto pos = v.Emplace(v.end(), Obj{1});
         assert(v.Size() == 1);
         assert(v.Capacity() >= v.Size());
         assert(&*pos == &v[0]);
@@ -507,7 +566,7 @@ void Test6() {
     {
         Obj::ResetCounters();
         Vector<Obj> v{SIZE};
-        auto* pos = v.Emplace(v.cbegin() + 1, ID, "Ivan"s);
+        auto pos = v.Emplace(v.cbegin() + 1, ID, "Ivan"s);
         assert(v.Size() == SIZE + 1);
         assert(v.Capacity() == SIZE * 2);
         assert(&*pos == &v[1]);
@@ -523,7 +582,7 @@ void Test6() {
     {
         Obj::ResetCounters();
         Vector<Obj> v{SIZE};
-        auto* pos = v.Emplace(v.cbegin() + v.Size(), ID, "Ivan"s);
+        auto pos = v.Emplace(v.cbegin() + v.Size(), ID, "Ivan"s);
         assert(v.Size() == SIZE + 1);
         assert(v.Capacity() == SIZE * 2);
         assert(&*pos == &v[SIZE]);
@@ -542,7 +601,7 @@ void Test6() {
         v.Reserve(SIZE * 2);
         const int old_num_moved = Obj::num_moved;
         assert(v.Capacity() == SIZE * 2);
-        auto* pos = v.Emplace(v.cbegin() + 3, ID, "Ivan"s);
+        auto pos = v.Emplace(v.cbegin() + 3, ID, "Ivan"s);
         assert(v.Size() == SIZE + 1);
         assert(&*pos == &v[3]);
         assert(v[3].id == ID);
@@ -558,7 +617,7 @@ void Test6() {
         Obj::ResetCounters();
         Vector<Obj> v{SIZE};
         v[2].id = ID;
-        auto* pos = v.Erase(v.cbegin() + 1);
+        auto pos = v.Erase(v.cbegin() + 1);
         assert((pos - v.begin()) == 1);
         assert(v.Size() == SIZE - 1);
         assert(v.Capacity() == SIZE);
@@ -571,84 +630,1970 @@ void Test6() {
     }
 }
 
-struct C {
-    C() noexcept {
-        ++def_ctor;
+void Test7() {
+    const size_t SIZE = 100;
+    const int ID = 42;
+    {
+        std::pmr::monotonic_buffer_resource arena;
+        using PmrVector = Vector<int, std::pmr::polymorphic_allocator<int>>;
+
+        PmrVector v(&arena);
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.PushBack(static_cast<int>(i));
+        }
+        assert(v.Size() == SIZE);
+        assert(v.GetAllocator().resource() == &arena);
+
+        // Копия получает аллокатор по умолчанию: polymorphic_allocator не распространяется при копировании
+        PmrVector v_copy(v);
+        assert(v_copy.GetAllocator().resource() == std::pmr::get_default_resource());
+        assert(v_copy[SIZE - 1] == static_cast<int>(SIZE - 1));
+
+        // При равных аллокаторах перемещение забирает буфер целиком
+        const int* old_data = &v[0];
+        PmrVector v_moved(&arena);
+        v_moved = std::move(v);
+        assert(&v_moved[0] == old_data);
+        assert(v.Size() == 0);
+
+        // При разных аллокаторах элементы перемещаются поэлементно в память приёмника
+        v_copy = std::move(v_moved);
+        assert(v_copy.GetAllocator().resource() == std::pmr::get_default_resource());
+        assert(&v_copy[0] != old_data);
+        assert(v_copy.Size() == SIZE);
+    }
+    {
+        Obj::ResetCounters();
+        std::pmr::unsynchronized_pool_resource pool;
+        Vector<Obj, std::pmr::polymorphic_allocator<Obj>> v(SIZE, &pool);
+        v[SIZE / 2].id = ID;
+        Vector<Obj, std::pmr::polymorphic_allocator<Obj>> other(&pool);
+        other.Swap(v);
+        assert(other.Size() == SIZE);
+        assert(other[SIZE / 2].id == ID);
+        assert(Obj::num_copied == 0 && Obj::num_moved == 0);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+}
+
+void Test8() {
+    const size_t SIZE = 10;
+    {
+        Vector<int> v;
+        for (int i = 0; i < static_cast<int>(SIZE); ++i) {
+            v.Insert(v.begin(), i);
+        }
+        v.Reserve(SIZE * 4);
+        v.Insert(v.begin() + 3, 100);
+        v.Erase(v.begin());
+        assert(v.Size() == SIZE);
+        assert(v[0] == 8 && v[2] == 100 && v[3] == 6 && v[SIZE - 1] == 0);
+        // Вставка существующего элемента при перемещении хвоста должна быть безопасна
+        v.Insert(v.begin(), v[2]);
+        assert(v[0] == 100 && v[1] == 8);
+    }
+    {
+        Handle::num_moved = 0;
+        Vector<Handle> v;
+        for (int i = 0; i < static_cast<int>(SIZE); ++i) {
+            v.EmplaceBack(i);
+        }
+        v.Reserve(SIZE * 4);
+        v.Emplace(v.begin() + 1, -1);
+        v.Erase(v.begin() + 2);
+        assert(Handle::num_moved == 0);
+        assert(v.Size() == SIZE);
+        assert(*v[0].value == 0 && *v[1].value == -1 && *v[2].value == 2);
+    }
+}
+
+void Test9() {
+    const size_t SIZE = 100'000;
+    {
+        // Порог в 64 КиБ: вектор проходит через realloc, переход в mmap и mremap
+        Vector<int, MallocAllocator<int, 1 << 16>> v;
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.PushBack(static_cast<int>(i));
+        }
+        v.Insert(v.begin() + 1, -1);
+        assert(v.Size() == SIZE + 1);
+        assert(v[0] == 0 && v[1] == -1 && v[SIZE] == static_cast<int>(SIZE - 1));
+
+        // Ёмкость включает запас, выделенный сверх запрошенного
+        v.Reserve(SIZE * 4);
+        assert(v.Capacity() >= SIZE * 4);
+        assert(v[SIZE] == static_cast<int>(SIZE - 1));
+
+        Vector<int, MallocAllocator<int, 1 << 16>> v_copy(v);
+        assert(v_copy[SIZE / 2] == v[SIZE / 2]);
     }
-    C(const C& /*other*/) noexcept {
-        ++copy_ctor;
+    {
+        Handle::num_moved = 0;
+        Vector<Handle, MallocAllocator<Handle>> v;
+        for (int i = 0; i < 100; ++i) {
+            v.EmplaceBack(i);
+        }
+        v.Emplace(v.begin(), std::move(v[99]));
+        assert(Handle::num_moved == 1);
+        assert(*v[0].value == 99 && *v[1].value == 0 && v[100].value == nullptr);
     }
-    C(C&& /*other*/) noexcept {
-        ++move_ctor;
+}
+
+void Test10() {
+    {
+        Vector<int, std::allocator<int>, OneAndHalfGrowth> v;
+        size_t capacities[6] = {};
+        for (size_t& capacity : capacities) {
+            v.PushBack(0);
+            capacity = v.Capacity();
+            while (v.Size() < v.Capacity()) {
+                v.PushBack(0);
+            }
+        }
+        assert(capacities[0] == 1 && capacities[1] == 2 && capacities[2] == 3);
+        assert(capacities[3] == 4 && capacities[4] == 6 && capacities[5] == 9);
     }
-    C& operator=(const C& other) noexcept {
-        if (this != &other) {
-            ++copy_assign;
+    {
+        Vector<int, std::allocator<int>, MinChunkGrowth<>> v;
+        v.PushBack(1);
+        assert(v.Capacity() == 64 / sizeof(int));
+    }
+    {
+        using Policy = CappedGrowth<64 * sizeof(int), 16 * sizeof(int)>;
+        Vector<int, std::allocator<int>, Policy> v;
+        for (int i = 0; i < 65; ++i) {
+            v.PushBack(i);
         }
-        return *this;
+        assert(v.Capacity() == 80);
+        assert(v[64] == 64);
     }
-    C& operator=(C&& /*other*/) noexcept {
-        ++move_assign;
-        return *this;
+    {
+        assert(SizeClassGrowth<>::NextCapacity(0, 1, sizeof(int)) == 4);
+        assert(SizeClassGrowth<>::NextCapacity(72, 73, 1) == 160);
+        assert(SizeClassGrowth<>::NextCapacity(4096, 4097, 1) == 8192);
+        assert(SizeClassGrowth<>::NextCapacity(3000, 5000, 1) == 8192);
+    }
+    {
+        Vector<char, MallocAllocator<char>> v;
+        v.PushBack('a');
+        assert(v.Capacity() >= 1);
+        const size_t capacity = v.Capacity();
+        while (v.Size() < capacity) {
+            v.PushBack('b');
+        }
+        assert(v.Capacity() == capacity);
+    }
+}
+
+void Test11() {
+    using namespace std::literals;
+    const size_t SIZE = 8;
+    const int ID = 42;
+    {
+        SmallVector<int, SIZE> v;
+        assert(v.Capacity() == SIZE && v.IsInline());
+        for (int i = 0; i < static_cast<int>(SIZE); ++i) {
+            v.PushBack(i);
+        }
+        assert(v.IsInline());
+        v.Insert(v.begin(), -1);
+        assert(!v.IsInline());
+        assert(v.Size() == SIZE + 1 && v.Capacity() == SIZE * 2);
+        assert(v[0] == -1 && v[SIZE] == static_cast<int>(SIZE - 1));
+    }
+    {
+        Obj::ResetCounters();
+        SmallVector<Obj, SIZE> v;
+        v.EmplaceBack(ID, "Ivan"s);
+        v.Emplace(v.begin(), 1);
+        assert(v.IsInline() && v.Size() == 2);
+        assert(v[1].id == ID);
+
+        SmallVector<Obj, SIZE> v_moved(std::move(v));
+        assert(v.Size() == 0 && v_moved.Size() == 2);
+        assert(Obj::num_copied == 0);
+
+        v_moved.Resize(SIZE * 2);
+        SmallVector<Obj, SIZE> v_copy(v_moved);
+        assert(v_copy.Size() == SIZE * 2 && !v_copy.IsInline());
+        v_copy.Erase(v_copy.begin());
+        assert(v_copy[0].id == ID);
+
+        v.Swap(v_copy);
+        assert(v.Size() == SIZE * 2 - 1 && v_copy.Size() == 0);
+        v_copy = v;
+        assert(v_copy.Size() == v.Size());
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        Obj::ResetCounters();
+        SmallVector<Obj, SIZE> v(SIZE);
+        v[SIZE - 1].throw_on_copy = true;
+        try {
+            SmallVector<Obj, SIZE> v_copy(v);
+            assert(false && "Exception is expected");
+        } catch (const std::runtime_error&) {
+        }
+        assert(Obj::GetAliveObjectCount() == SIZE);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+}
+
+void Test12() {
+    const size_t SIZE = 10;
+    const int ID = 42;
+    {
+        const std::list<int> source{1, 2, 3, 4};
+        Vector<int> v(source.begin(), source.end());
+        assert(v.Size() == 4 && v.Capacity() == 4);
+
+        v.Insert(v.begin() + 1, {7, 8});
+        v.Insert(v.end(), 2, 9);
+        v.Append(source.begin(), source.end());
+        const int expected[] = {1, 7, 8, 2, 3, 4, 9, 9, 1, 2, 3, 4};
+        assert(v.Size() == std::size(expected));
+        assert(std::equal(v.begin(), v.end(), std::begin(expected)));
+
+        // Копии элемента самого вектора вставляются корректно даже при сдвиге
+        v.Reserve(v.Size() * 2);
+        v.Insert(v.begin(), 3, v[1]);
+        assert(v[0] == 7 && v[2] == 7 && v[3] == 1 && v[4] == 7);
+
+        std::istringstream input("5 6 7");
+        v.Assign(std::istream_iterator<int>(input), std::istream_iterator<int>());
+        assert(v.Size() == 3 && v[0] == 5 && v[2] == 7);
+        v.Assign(4, v[1]);
+        assert(v.Size() == 4 && v[3] == 6);
+    }
+    {
+        Obj::ResetCounters();
+        Vector<Obj> v(SIZE);
+        Vector<Obj> source(SIZE / 2);
+        source[0].id = ID;
+        v.Insert(v.begin() + 2, source.begin(), source.end());
+        assert(v.Size() == SIZE + SIZE / 2);
+        assert(v.Capacity() == SIZE * 2);
+        assert(v[2].id == ID);
+        assert(Obj::num_copied == static_cast<int>(SIZE / 2));
+        assert(Obj::num_moved == static_cast<int>(SIZE));
+    }
+    {
+        Obj::ResetCounters();
+        Vector<Obj> v(SIZE);
+        v.Reserve(SIZE * 2);
+        v[SIZE - 1].id = ID;
+        Obj obj{1};
+        // Хвост длиннее вставки и короче вставки
+        v.Insert(v.begin() + 1, 3, obj);
+        v.Insert(v.end() - 2, 4, obj);
+        assert(v.Size() == SIZE + 7);
+        assert(v[1].id == 1 && v[3].id == 1 && v[4].id == 0);
+        assert(v[SIZE + 1].id == 1 && v[SIZE + 6].id == ID);
+        assert(Obj::num_copied + Obj::num_assigned == 7);
+        assert(Obj::GetAliveObjectCount() == static_cast<int>(SIZE + 8));
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+}
+
+void Test13() {
+    const size_t SIZE = 10;
+    {
+        Vector<int> v{0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+        auto pos = v.Erase(v.begin() + 2, v.begin() + 5);
+        assert(pos == v.begin() + 2 && *pos == 5);
+        assert(v.Size() == 7 && v.Capacity() == SIZE);
+        assert(v.Erase(v.begin(), v.begin()) == v.begin() && v.Size() == 7);
+
+        pos = v.SwapRemove(v.begin());
+        assert(*pos == 9 && v.Size() == 6 && v.Back() == 8);
+
+        const size_t removed = EraseIf(v, [](int value) { return value % 2 == 0; });
+        assert(removed == 2);
+        assert(v.Size() == 4 && v[0] == 9 && v[1] == 1 && v[2] == 5 && v[3] == 7);
+    }
+    {
+        Obj::ResetCounters();
+        Vector<Obj> v(SIZE);
+        for (size_t i = 0; i < SIZE; ++i) {
+            v[i].id = static_cast<int>(i);
+        }
+        v.Erase(v.begin() + 1, v.begin() + 3);
+        assert(v.Size() == SIZE - 2 && v[1].id == 3);
+        assert(Obj::num_move_assigned == static_cast<int>(SIZE - 3));
+
+        v.SwapRemove(v.end() - 1);
+        assert(v.Size() == SIZE - 3 && v.Back().id == static_cast<int>(SIZE - 2));
+
+        EraseIf(v, [](const Obj& obj) { return obj.id > 4; });
+        assert(v.Size() == 3 && v[2].id == 4);
+        assert(Obj::GetAliveObjectCount() == 3);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+}
+
+void Test14() {
+    const size_t SIZE = 100;
+    {
+        Vector<int> v(SIZE, DEFAULT_INIT);
+        assert(v.Size() == SIZE && v.Capacity() == SIZE);
+        v.ResizeDefaultInit(SIZE / 2);
+        assert(v.Size() == SIZE / 2 && v.Capacity() == SIZE);
+        v.ResizeDefaultInit(SIZE * 2);
+        assert(v.Size() == SIZE * 2);
+    }
+    {
+        Obj::ResetCounters();
+        Vector<Obj> v(SIZE, DEFAULT_INIT);
+        v.ResizeDefaultInit(SIZE * 2);
+        assert(Obj::num_default_constructed == static_cast<int>(SIZE * 2));
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        Vector<char> v;
+        v.PushBack('>');
+        v.ResizeAndOverwrite(SIZE, [](char* data, size_t count) {
+            assert(data[0] == '>');
+            const char text[] = " read";
+            std::copy(std::begin(text), std::end(text) - 1, data + 1);
+            return std::min(count, std::size(text));
+        });
+        assert(v.Size() == 6 && v.Capacity() >= SIZE);
+        assert(std::string(v.begin(), v.end()) == "> read");
+    }
+}
+
+void Test15() {
+    using namespace std::literals;
+    static_assert(std::is_nothrow_move_constructible_v<Vector<Obj>>);
+    static_assert(std::is_nothrow_move_assignable_v<Vector<Obj>>);
+    {
+        Obj::ResetCounters();
+        Vector<Obj> v{{1, "Ivan"s}, {2, "Misha"s}};
+        assert(v.Size() == 2 && v.Capacity() == 2);
+        assert(v[1].id == 2);
+        assert(Obj::num_copied == 2);
+        assert(Obj::GetAliveObjectCount() == 2);
     }
-    ~C() {
-        ++dtor;
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        // std::vector перемещает вложенные Vector при росте, а не копирует их
+        std::vector<Vector<Obj>> nested;
+        nested.emplace_back(10);
+        Obj::ResetCounters();
+        for (int i = 0; i < 10; ++i) {
+            nested.emplace_back(1);
+        }
+        assert(Obj::num_copied == 0 && Obj::num_moved == 0);
+    }
+}
+
+struct ParserCallSite {};
+
+inline size_t shift_events = 0;
+
+void Test16() {
+    using CountedVector = Vector<Obj, std::allocator<Obj>, DoublingGrowth, CountingVectorStats<ParserCallSite>>;
+    static_assert(sizeof(CountedVector) == sizeof(Vector<Obj>));
+
+    const size_t SIZE = 8;
+    {
+        CountingVectorStats<ParserCallSite>::Reset();
+        CountedVector v;
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.EmplaceBack();
+        }
+        v.Insert(v.begin(), Obj{});
+        v.Erase(v.begin() + 1);
+
+        const VectorStats stats = CountingVectorStats<ParserCallSite>::Get();
+        // Ёмкости 1, 2, 4, 8, 16: первое выделение не является реаллокацией
+        assert(stats.reallocations == 4);
+        assert(stats.bytes_allocated == (1 + 2 + 4 + 8 + 16) * sizeof(Obj));
+        assert(stats.elements_moved == 1 + 2 + 4 + 8);
+        assert(stats.elements_copied == 0);
+        assert(stats.elements_shifted == SIZE - 1);
+        assert(stats.peak_capacity == SIZE * 2);
+    }
+    {
+        using CallbackVector = Vector<int, std::allocator<int>, DoublingGrowth, CallbackVectorStats<ParserCallSite>>;
+        shift_events = 0;
+        CallbackVectorStats<ParserCallSite>::SetCallback([](const VectorEvent& event) {
+            if (event.kind == VectorEventKind::SHIFT) {
+                ++shift_events;
+            }
+        });
+        CallbackVector v(SIZE);
+        v.Erase(v.begin());
+        v.Insert(v.begin(), 1);
+        CallbackVectorStats<ParserCallSite>::SetCallback(nullptr);
+        assert(shift_events == 2);
     }
+}
+
+void Test17() {
+    const size_t SIZE = 100'000;
+    {
+        using Allocator = HugePageAllocator<int, 1 << 16>;
+        Vector<int, Allocator> v(Allocator(NumaPolicy{NumaMode::INTERLEAVE, 1}));
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.PushBack(static_cast<int>(i));
+        }
+        assert(v.GetAllocator().GetNumaPolicy().mode == NumaMode::INTERLEAVE);
+        assert(v[SIZE - 1] == static_cast<int>(SIZE - 1));
 
-    static void Reset() {
-        def_ctor = 0;
-        copy_ctor = 0;
-        move_ctor = 0;
-        copy_assign = 0;
-        move_assign = 0;
-        dtor = 0;
+        // Крупный буфер выровнен по huge page и занимает целое их число
+        assert(reinterpret_cast<uintptr_t>(&v[0]) % Allocator::HUGE_PAGE_SIZE == 0);
+        assert(v.Capacity() * sizeof(int) % Allocator::HUGE_PAGE_SIZE == 0);
     }
+    {
+        Vector<double, HugePageAllocator<double>> v(SIZE, HugePageAllocator<double>({}, HugePageMode::EXPLICIT));
+        v.Resize(SIZE * 4);
+        assert(v.Size() == SIZE * 4 && v[SIZE * 4 - 1] == 0.0);
+    }
+}
 
-    inline static size_t def_ctor = 0;
-    inline static size_t copy_ctor = 0;
-    inline static size_t move_ctor = 0;
-    inline static size_t copy_assign = 0;
-    inline static size_t move_assign = 0;
-    inline static size_t dtor = 0;
+struct alignas(128) Padded {
+    int value = 0;
 };
 
-void Dump() {
-    using namespace std;
-    cerr << "Def ctors: "sv << C::def_ctor              //
-         << ", Copy ctors: "sv << C::copy_ctor          //
-         << ", Move ctors: "sv << C::move_ctor          //
-         << ", Copy assignments: "sv << C::copy_assign  //
-         << ", Move assignments: "sv << C::move_assign  //
-         << ", Dtors: "sv << C::dtor << endl;
+void Test18() {
+    {
+        // std::allocator использует выровненный operator new для типов с повышенным выравниванием
+        Vector<Padded> v(3);
+        v.PushBack(Padded{7});
+        assert(reinterpret_cast<uintptr_t>(&v[0]) % alignof(Padded) == 0);
+        assert(v[3].value == 7);
+    }
+    {
+        using Allocator = AlignedAllocator<float, 64>;
+        Vector<float, Allocator> v;
+        for (int i = 0; i < 100; ++i) {
+            v.PushBack(static_cast<float>(i));
+            assert(reinterpret_cast<uintptr_t>(&v[0]) % 64 == 0);
+            // Ёмкость занимает целое число кэш-линий
+            assert(v.Capacity() * sizeof(float) % 64 == 0);
+        }
+        assert(v[99] == 99.0f);
+
+        Vector<float, Allocator> copy = v;
+        assert(reinterpret_cast<uintptr_t>(&copy[0]) % 64 == 0 && copy[50] == 50.0f);
+    }
+    {
+        Vector<Padded, AlignedAllocator<Padded, 16>> v(2);
+        static_assert(AlignedAllocator<Padded, 16>::alignment == alignof(Padded));
+        assert(reinterpret_cast<uintptr_t>(&v[0]) % alignof(Padded) == 0);
+    }
 }
 
-void Benchmark() {
-    using namespace std;
-    try {
-        const size_t NUM = 10;
-        C c;
-        {
-            cerr << "std::vector:"sv << endl;
-            C::Reset();
-            vector<C> v(NUM);
-            Dump();
-            v.push_back(c);
+struct Record {
+    int64_t key;
+    double value;
+};
+
+void Test19() {
+    const std::string path = "/tmp/advanced_vector_test_" + std::to_string(getpid()) + ".bin";
+    const size_t SIZE = 10'000;
+    {
+        MappedVector<Record> v(path, MappedVectorMode::CREATE);
+        assert(v.Empty() && v.IsWritable());
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.PushBack({static_cast<int64_t>(i), i * 0.5});
         }
-        Dump();
-    } catch (...) {
+        // Аргумент ссылается на элемент, который переезжает при росте
+        v.Reserve(v.Size());
+        v.EmplaceBack(v[0]);
+        assert(v.Size() == SIZE + 1 && v[SIZE].key == 0);
+        v.PopBack();
+        v.ShrinkToFit();
+        assert(v.Capacity() == SIZE);
+        v.Sync();
     }
-    try {
-        const size_t NUM = 10;
-        C c;
-        {
-            cerr << "Vector:"sv << endl;
-            C::Reset();
-            Vector<C> v(NUM);
-            Dump();
-            v.PushBack(c);
+    {
+        const MappedVector<Record> v(path, MappedVectorMode::READ_ONLY);
+        assert(v.Size() == SIZE && !v.IsWritable());
+        assert(v[SIZE - 1].key == static_cast<int64_t>(SIZE - 1) && v[SIZE - 1].value == (SIZE - 1) * 0.5);
+
+        int64_t sum = 0;
+        for (const Record& record : v) {
+            sum += record.key;
+        }
+        assert(sum == static_cast<int64_t>(SIZE * (SIZE - 1) / 2));
+    }
+    {
+        MappedVector<Record> v(path);
+        v.Resize(SIZE / 2);
+        v.Resize(SIZE);
+        assert(v[SIZE - 1].key == 0);
+
+        MappedVector<Record> moved = std::move(v);
+        assert(!v.IsOpen() && v.Size() == 0 && moved.Size() == SIZE);
+    }
+    {
+        try {
+            MappedVector<int> v(path);
+            assert(false);
+        } catch (const std::runtime_error&) {
+        }
+        try {
+            MappedVector<int> v(path + ".missing", MappedVectorMode::READ_ONLY);
+            assert(false);
+        } catch (const std::system_error&) {
+        }
+    }
+    std::remove(path.c_str());
+}
+
+struct Point {
+    int x = 0;
+    int y = 0;
+};
+
+void Test20() {
+    {
+        Vector<Record> v;
+        for (int i = 0; i < 1000; ++i) {
+            v.PushBack(Record{i, i * 2.0});
+        }
+        std::stringstream stream;
+        Serialize(v, stream);
+
+        Vector<Record> result;
+        Deserialize(stream, result);
+        assert(result.Size() == 1000 && result.Capacity() == 1000);
+        assert(result[999].key == 999 && result[999].value == 1998.0);
+    }
+    {
+        // Элементы с инициализаторами членов тривиально копируемы и читаются в неинициализированный буфер
+        Vector<Point> v{{1, 2}, {3, 4}};
+        std::stringstream stream;
+        Serialize(v, stream);
+
+        Vector<Point> result;
+        Deserialize(stream, result);
+        assert(result.Size() == 2 && result[1].x == 3 && result[1].y == 4);
+    }
+    {
+        Vector<std::string> v{"alpha", "", std::string(100, 'x')};
+        std::stringstream stream;
+        Serialize(v, stream);
+
+        Vector<std::string> result{"old"};
+        Deserialize(stream, result);
+        assert(result.Size() == 3 && result[0] == "alpha" && result[1].empty() && result[2].size() == 100);
+
+        // Длина строки и размер вектора из повреждённых данных не выделяют память заранее
+        std::string corrupt = stream.str().substr(0, sizeof(SerializedVectorHeader));
+        const uint64_t huge = uint64_t{1} << 40;
+        std::memcpy(corrupt.data() + offsetof(SerializedVectorHeader, size), &huge, sizeof(huge));
+        corrupt.append(reinterpret_cast<const char*>(&huge), sizeof(huge));
+        corrupt.append("abc");
+        std::stringstream corrupt_stream(corrupt);
+        try {
+            Deserialize(corrupt_stream, result);
+            assert(false);
+        } catch (const std::runtime_error&) {
+        }
+        assert(result.Size() == 3 && result[0] == "alpha");
+
+        // Строка длиннее одного блока чтения
+        Vector<std::string> long_strings{std::string(3'000'000, 'y')};
+        std::stringstream long_stream;
+        Serialize(long_strings, long_stream);
+        Deserialize(long_stream, result);
+        assert(result.Size() == 1 && result[0] == long_strings[0]);
+    }
+    {
+        Vector<int> v{1, 2, 3};
+        std::stringstream stream;
+        Serialize(v, stream);
+        const std::string bytes = stream.str();
+
+        // Обрезанные данные и другой тип элементов не меняют целевой вектор
+        std::stringstream truncated(bytes.substr(0, bytes.size() - 1));
+        Vector<int> result{7};
+        try {
+            Deserialize(truncated, result);
+            assert(false);
+        } catch (const std::runtime_error&) {
+        }
+        assert(result.Size() == 1 && result[0] == 7);
+
+        std::stringstream other_type(bytes);
+        Vector<double> doubles;
+        try {
+            Deserialize(other_type, doubles);
+            assert(false);
+        } catch (const std::runtime_error&) {
+        }
+    }
+    {
+        const std::string path = "/tmp/advanced_vector_serialized_" + std::to_string(getpid()) + ".bin";
+        Vector<int> v;
+        for (int i = 0; i < 100'000; ++i) {
+            v.PushBack(i);
+        }
+
+        int fd = ::open(path.c_str(), O_CREAT | O_TRUNC | O_WRONLY, 0644);
+        assert(fd >= 0);
+        Serialize(v, fd);
+        ::close(fd);
+
+        fd = ::open(path.c_str(), O_RDONLY);
+        Vector<int> result;
+        Deserialize(fd, result);
+        ::close(fd);
+        std::remove(path.c_str());
+
+        assert(result.Size() == v.Size() && result[99'999] == 99'999);
+
+        // Размер из заголовка больше файла: ошибка до выделения памяти под 2^40 элементов
+        SerializedVectorHeader header;
+        header.element_size = sizeof(int);
+        header.size = uint64_t{1} << 40;
+        fd = ::open(path.c_str(), O_CREAT | O_TRUNC | O_RDWR, 0644);
+        assert(fd >= 0 && ::write(fd, &header, sizeof(header)) == static_cast<ssize_t>(sizeof(header)));
+        ::lseek(fd, 0, SEEK_SET);
+        try {
+            Deserialize(fd, result);
+            assert(false);
+        } catch (const std::runtime_error&) {
+        }
+        ::close(fd);
+        std::remove(path.c_str());
+        assert(result.Size() == v.Size());
+    }
+}
+
+// Бросает исключение при конструировании с номером throw_at и считает живые объекты
+struct Counted {
+    static inline std::atomic<int> alive{0};
+    static inline std::atomic<int> constructed{0};
+    static inline int throw_at = -1;
+
+    Counted() {
+        Register();
+    }
+    Counted(const Counted& other) : value(other.value) {
+        Register();
+    }
+    Counted& operator=(const Counted&) = default;
+    ~Counted() {
+        --alive;
+    }
+
+    int value = 1;
+
+private:
+    void Register() {
+        if (constructed++ == throw_at) {
+            throw std::runtime_error("construction failed");
         }
-        Dump();
-    } catch (...) {
+        ++alive;
+    }
+};
+
+// Некопируемый тип, перемещение которого может бросить исключение
+struct ThrowingMoveOnly {
+    static inline int moves_until_throw = -1;
+
+    explicit ThrowingMoveOnly(int value) : value(value) {
+    }
+    ThrowingMoveOnly(const ThrowingMoveOnly&) = delete;
+    ThrowingMoveOnly(ThrowingMoveOnly&& other) : value(other.value) {
+        if (moves_until_throw >= 0 && moves_until_throw-- == 0) {
+            throw std::runtime_error("move failed");
+        }
+    }
+    ThrowingMoveOnly& operator=(const ThrowingMoveOnly&) = delete;
+    ThrowingMoveOnly& operator=(ThrowingMoveOnly&&) = default;
+
+    int value = 0;
+};
+
+// Считает перемещения, чтобы проверить объём переноса за одно добавление
+struct MoveCounted {
+    static inline size_t moves = 0;
+
+    explicit MoveCounted(int value) : value(value) {
+    }
+    MoveCounted(MoveCounted&& other) noexcept : value(other.value) {
+        ++moves;
+    }
+    MoveCounted& operator=(MoveCounted&&) = delete;
+
+    int value = 0;
+};
+
+void Test21() {
+    const ParallelTag policy{4, 100};
+    {
+        Vector<int> v(policy, 10'000);
+        assert(v.Size() == 10'000 && std::all_of(v.begin(), v.end(), [](int x) { return x == 0; }));
+
+        v.Resize(policy, 25'000);
+        assert(v.Size() == 25'000 && v[24'999] == 0);
+        v.Resize(policy, 10);
+        assert(v.Size() == 10);
+
+        v.Assign(policy, 5'000, 7);
+        assert(v.Size() == 5'000 && std::all_of(v.begin(), v.end(), [](int x) { return x == 7; }));
+    }
+    {
+        Vector<std::string> source;
+        for (int i = 0; i < 1'000; ++i) {
+            source.PushBack(std::to_string(i));
+        }
+        const Vector<std::string> copy(policy, source);
+        assert(copy.Size() == 1'000 && copy[0] == "0" && copy[999] == "999");
+
+        // Мелкий вектор строится в вызывающем потоке
+        const Vector<int> small(PARALLEL, 3);
+        assert(small.Size() == 3);
+    }
+    {
+        Counted::throw_at = 777;
+        try {
+            Vector<Counted> v(policy, 1'000);
+            assert(false);
+        } catch (const std::runtime_error&) {
+        }
+        assert(Counted::alive == 0);
+
+        Counted::throw_at = -1;
+        Vector<Counted> v(policy, 500);
+        assert(Counted::alive == 500);
+
+        Counted::constructed = 0;
+        Counted::throw_at = 300;
+        try {
+            v.Resize(policy, 1'000);
+            assert(false);
+        } catch (const std::runtime_error&) {
+        }
+        assert(v.Size() == 500 && Counted::alive == 500);
+
+        Counted::constructed = 0;
+        try {
+            v.Assign(policy, 1'000, Counted());
+            assert(false);
+        } catch (const std::runtime_error&) {
+        }
+        assert(v.Size() == 500 && Counted::alive == 500);
+        Counted::throw_at = -1;
+    }
+    assert(Counted::alive == 0);
+}
+
+void Test22() {
+    {
+        ConcurrentVector<int, std::allocator<int>, 4> v;
+        assert(v.Empty() && v.Capacity() == 0);
+
+        int& first = v.EmplaceBack(1);
+        for (int i = 2; i <= 100; ++i) {
+            v.PushBack(i);
+        }
+        // Сегменты не перемещаются при росте
+        assert(&first == &v[0] && v.Size() == 100 && v[99] == 100);
+        assert(v.Capacity() >= 100);
+
+        v.Reserve(1'000);
+        assert(v.Capacity() >= 1'000);
+
+        int sum = 0;
+        v.ForEach([&sum](int x) { sum += x; });
+        assert(sum == 5'050);
+    }
+    {
+        const size_t THREADS = 8;
+        const size_t PER_THREAD = 20'000;
+        ConcurrentVector<size_t> v;
+        std::atomic<bool> done{false};
+
+        // Читатель видит только полностью построенные элементы опубликованного префикса
+        std::thread reader([&] {
+            size_t previous = 0;
+            while (!done.load()) {
+                const size_t size = v.Size();
+                assert(size >= previous);
+                for (size_t i = previous; i < size; ++i) {
+                    assert(v[i] % PER_THREAD < PER_THREAD && v[i] / PER_THREAD < THREADS);
+                }
+                previous = size;
+            }
+        });
+
+        std::vector<std::thread> writers;
+        for (size_t t = 0; t < THREADS; ++t) {
+            writers.emplace_back([&v, t] {
+                for (size_t i = 0; i < PER_THREAD; ++i) {
+                    v.PushBack(t * PER_THREAD + i);
+                }
+            });
+        }
+        for (std::thread& writer : writers) {
+            writer.join();
+        }
+        done = true;
+        reader.join();
+
+        assert(v.Size() == THREADS * PER_THREAD);
+        std::vector<bool> seen(THREADS * PER_THREAD);
+        v.ForEach([&seen](size_t x) { seen[x] = true; });
+        assert(std::all_of(seen.begin(), seen.end(), [](bool x) { return x; }));
+    }
+    {
+        // Конструктор std::string из const char* не noexcept: строка строится заранее
+        ConcurrentVector<std::string> v;
+        v.EmplaceBack("alpha");
+        v.EmplaceBack(std::string(100, 'x'));
+        assert(v.Size() == 2 && v[0] == "alpha" && v[1].size() == 100);
+    }
+}
+
+void Test23() {
+    {
+        SegmentedVector<int, std::allocator<int>, 4> v;
+        assert(v.Empty() && v.Capacity() == 0);
+
+        int& first = v.EmplaceBack(0);
+        const int* first_address = &first;
+        for (int i = 1; i < 1'000; ++i) {
+            v.PushBack(i);
+        }
+        // Рост добавляет сегменты, не перемещая элементы
+        assert(first_address == &v[0] && v.Size() == 1'000);
+        assert(v.Front() == 0 && v.Back() == 999 && v.At(500) == 500);
+
+        // Аргумент ссылается на элемент вектора
+        while (v.Size() != v.Capacity()) {
+            v.PushBack(0);
+        }
+        v.EmplaceBack(v[1]);
+        assert(v.Back() == 1);
+
+        try {
+            v.At(v.Size());
+            assert(false);
+        } catch (const std::out_of_range&) {
+        }
+
+        for (size_t i = 0; i < v.Size(); ++i) {
+            assert(v[i] == (i < 1'000 ? static_cast<int>(i) : i + 1 == v.Size() ? 1 : 0));
+        }
+    }
+    {
+        SegmentedVector<std::string> v{"a", "b", "c"};
+        v.Resize(100);
+        assert(v.Size() == 100 && v[2] == "c" && v[99].empty());
+        v.Resize(2);
+        assert(v.Size() == 2 && v.Back() == "b");
+
+        SegmentedVector<std::string> copy = v;
+        copy.PushBack("d");
+        assert(copy.Size() == 3 && v.Size() == 2);
+
+        SegmentedVector<std::string> moved = std::move(copy);
+        assert(moved.Size() == 3 && copy.Empty());
+        v = moved;
+        assert(v.Size() == 3 && v[2] == "d");
+    }
+    {
+        SegmentedVector<int> v;
+        for (int i = 0; i < 100; ++i) {
+            v.PushBack(100 - i);
+        }
+        // Итераторы произвольного доступа подходят для алгоритмов стандартной библиотеки
+        std::sort(v.begin(), v.end());
+        assert(std::is_sorted(v.cbegin(), v.cend()) && v[0] == 1 && v.end() - v.begin() == 100);
+
+        const SegmentedVector<int>& cv = v;
+        SegmentedVector<int>::const_iterator it = v.begin();
+        assert(*(it + 10) == 11 && it[20] == cv[20]);
+    }
+}
+
+void Test24() {
+    {
+        IncrementalVector<int> v;
+        for (int i = 0; i < 1'000; ++i) {
+            v.PushBack(i);
+            // Во время переноса элементы читаются из обоих буферов
+            for (int j = std::max(0, i - 20); j <= i; ++j) {
+                assert(v[j] == j);
+            }
+            if (i == 600) {
+                // После роста 512 -> 1024 перенесены ещё не все элементы
+                assert(v.Capacity() == 1'024 && v.IsMigrating());
+                size_t index = 0;
+                v.ForEach([&index](int x) { assert(x == static_cast<int>(index++)); });
+                assert(index == 601);
+            }
+        }
+        // Два элемента за добавление: перенос завершается задолго до заполнения буфера
+        assert(v.Size() == 1'000 && v.Back() == 999 && !v.IsMigrating());
+
+        v.PushBack(1'000);
+        v.FinishMigration();
+        assert(!v.IsMigrating() && v[0] == 0 && v[1'000] == 1'000);
+    }
+    {
+        IncrementalVector<std::string, std::allocator<std::string>, DoublingGrowth, 1> v;
+        for (int i = 0; i < 100; ++i) {
+            v.PushBack(std::to_string(i));
+        }
+        // Аргумент ссылается на элемент, который переедет в новый буфер
+        while (v.Size() != v.Capacity()) {
+            v.PushBack(std::string(20, 'x'));
+        }
+        v.PushBack(v[0]);
+        assert(v.IsMigrating() && v.Back() == "0" && v[0] == "0");
+
+        while (v.Size() > 10) {
+            v.PopBack();
+        }
+        assert(v[9] == "9");
+
+        IncrementalVector<std::string, std::allocator<std::string>, DoublingGrowth, 1> copy = v;
+        assert(!copy.IsMigrating() && copy.Size() == 10 && copy[5] == "5");
+
+        v.Reserve(1'000);
+        assert(!v.IsMigrating() && v.Capacity() == 1'000 && v.At(9) == "9");
+    }
+    {
+        // Перенос копированием: исключение в переносе откатывает добавление
+        Counted::throw_at = -1;
+        IncrementalVector<Counted> v;
+        for (int i = 0; i < 5; ++i) {
+            v.EmplaceBack();
+        }
+        assert(v.IsMigrating());
+
+        Counted::constructed = 0;
+        Counted::throw_at = 1;
+        try {
+            v.EmplaceBack();
+            assert(false);
+        } catch (const std::runtime_error&) {
+        }
+        Counted::throw_at = -1;
+        assert(v.Size() == 5 && Counted::alive == 5);
+    }
+    assert(Counted::alive == 0);
+    {
+        // При линейном росте на 64 элемента порция переноса растёт с размером, но ни одно
+        // добавление не переносит весь старый буфер
+        IncrementalVector<MoveCounted, std::allocator<MoveCounted>, CappedGrowth<64, 64 * sizeof(MoveCounted)>> v;
+        size_t max_moves = 0;
+        for (int i = 0; i < 4'000; ++i) {
+            MoveCounted::moves = 0;
+            v.EmplaceBack(i);
+            max_moves = std::max(max_moves, MoveCounted::moves);
+        }
+        assert(v.Size() == 4'000 && v[0].value == 0 && v[3'999].value == 3'999 && max_moves <= 64);
+
+        // Рост в полтора раза с шагом 1 требует переносить по два элемента за добавление
+        IncrementalVector<MoveCounted, std::allocator<MoveCounted>, OneAndHalfGrowth, 1> w;
+        max_moves = 0;
+        for (int i = 0; i < 4'000; ++i) {
+            MoveCounted::moves = 0;
+            w.EmplaceBack(i);
+            max_moves = std::max(max_moves, MoveCounted::moves);
+        }
+        assert(w[0].value == 0 && w[3'999].value == 3'999 && max_moves <= 3);
+    }
+}
+
+void Test25() {
+    {
+        Vector<std::string> v;
+        for (int i = 0; i < 100; ++i) {
+            v.PushBack(std::to_string(i));
+        }
+        const size_t capacity = v.Capacity();
+        v.Clear();
+        assert(v.Size() == 0 && v.Capacity() == capacity);
+
+        v.PushBack("a");
+        v.PushBack("b");
+        v.ShrinkToFit();
+        assert(v.Capacity() == 2 && v[0] == "a" && v[1] == "b");
+
+        v.Clear();
+        v.ShrinkToFit();
+        assert(v.Capacity() == 0);
+        v.PushBack("c");
+        assert(v.Size() == 1 && v[0] == "c");
+    }
+    {
+        // Тривиально перемещаемые элементы сжимаются через realloc на месте
+        Vector<int, MallocAllocator<int>> v;
+        v.Reserve(1'000);
+        v.PushBack(1);
+        v.PushBack(2);
+        v.ShrinkToFit();
+        assert(v.Capacity() < 1'000 && v.Size() == 2 && v[1] == 2);
+    }
+    {
+        // Буфер передаётся в C-код и обратно без копирования
+        Vector<int, MallocAllocator<int>> v{1, 2, 3};
+        const int* address = &v[0];
+        VectorBuffer<int> buffer = v.Release();
+        assert(v.Size() == 0 && v.Capacity() == 0);
+        assert(buffer.data == address && buffer.size == 3 && buffer.capacity >= 3);
+
+        Vector<int, MallocAllocator<int>> other{7};
+        other.Adopt(buffer);
+        assert(&other[0] == address && other.Size() == 3 && other[2] == 3);
+        other.PushBack(4);
+
+        buffer = other.Release();
+        std::free(buffer.data);
+
+        int* c_array = static_cast<int*>(std::malloc(4 * sizeof(int)));
+        c_array[0] = 10;
+        v.Adopt(c_array, 1, 4);
+        v.PushBack(11);
+        assert(v.Size() == 2 && v.Capacity() == 4 && v[0] == 10 && v[1] == 11);
+    }
+    {
+        Vector<std::string> v{"x", "y"};
+        Vector<std::string> other;
+        other.Adopt(v.Release());
+        assert(other.Size() == 2 && other[1] == "y" && v.Size() == 0);
+    }
+}
+
+void Test26() {
+    {
+        SoaVector<float, int, std::string> v;
+        for (int i = 0; i < 100; ++i) {
+            v.EmplaceBack(i * 0.5f, i, std::to_string(i));
+        }
+        v.PushBack({1.0f, -1, "last"});
+        assert(v.Size() == 101 && v.Capacity() >= 101);
+
+        auto [x, id, name] = v[10];
+        assert(x == 5.0f && id == 10 && name == "10");
+        std::get<1>(v[10]) = 42;
+        assert(std::get<1>(v[10]) == 42);
+
+        // Столбец лежит в памяти подряд
+        float sum = 0.0f;
+        for (float value : v.Column<0>()) {
+            sum += value;
+        }
+        assert(sum == 2476.0f && v.Column<0>().Size() == 101);
+        assert(&v.Column<1>()[1] == &v.Column<1>()[0] + 1);
+
+        int count = 0;
+        for (auto [px, pid, pname] : v) {
+            assert(pid == 42 || pid == -1 || std::to_string(pid) == pname);
+            (void)px;
+            ++count;
+        }
+        assert(count == 101);
+
+        // Аргумент ссылается на элемент вектора при росте
+        while (v.Size() != v.Capacity()) {
+            v.EmplaceBack(0.0f, 0, "pad");
+        }
+        v.EmplaceBack(std::get<0>(v[1]), std::get<1>(v[1]), std::get<2>(v[1]));
+        assert(std::get<2>(v[v.Size() - 1]) == "1");
+    }
+    {
+        SoaVector<int, std::string> v(3);
+        assert(v.Size() == 3 && std::get<0>(v[2]) == 0 && std::get<1>(v[2]).empty());
+
+        SoaVector<int, std::string> copy = v;
+        copy.EmplaceBack(7, "seven");
+        v = copy;
+        assert(v.Size() == 4 && std::get<1>(v[3]) == "seven");
+
+        SoaVector<int, std::string> moved = std::move(copy);
+        assert(moved.Size() == 4 && copy.Size() == 0);
+
+        moved.PopBack();
+        moved.Resize(1);
+        assert(moved.Size() == 1);
+        moved.Clear();
+        assert(moved.Empty());
+
+        const SoaVector<int, std::string>& cv = v;
+        assert(std::get<0>(*(cv.begin() + 3)) == 7 && cv.end() - cv.begin() == 4);
+    }
+    {
+        // Исключение при копировании второго столбца оставляет вектор без изменений
+        Counted::throw_at = -1;
+        SoaVector<int, Counted> v;
+        v.EmplaceBack(1, Counted());
+        v.EmplaceBack(2, Counted());
+        Counted::constructed = 0;
+        Counted::throw_at = 2;
+        try {
+            v.EmplaceBack(3, Counted());
+            assert(false);
+        } catch (const std::runtime_error&) {
+        }
+        Counted::throw_at = -1;
+        assert(v.Size() == 2 && std::get<0>(v[1]) == 2 && Counted::alive == 2);
+    }
+    assert(Counted::alive == 0);
+    {
+        // Бросающее перемещение некопируемого столбца не прерывает программу: рост
+        // откатывается, элементы остаются в старых буферах
+        SoaVector<int, ThrowingMoveOnly> v;
+        for (int i = 0; i < 8; ++i) {
+            v.EmplaceBack(i, ThrowingMoveOnly(i));
+        }
+        const size_t capacity = v.Capacity();
+        ThrowingMoveOnly::moves_until_throw = 3;
+        try {
+            v.Reserve(100);
+            assert(false);
+        } catch (const std::runtime_error&) {
+        }
+        ThrowingMoveOnly::moves_until_throw = -1;
+        assert(v.Size() == 8 && v.Capacity() == capacity && std::get<0>(v[7]) == 7);
+
+        v.Reserve(100);
+        assert(v.Capacity() == 100 && std::get<0>(v[5]) == 5 && std::get<1>(v[5]).value == 5);
+    }
+}
+
+// Сверяет все варианты ядер со скалярными циклами на размерах с неполными регистрами
+template <typename T>
+void CheckSimdAlgorithms(size_t size) {
+    Vector<T> v;
+    for (size_t i = 0; i < size; ++i) {
+        v.PushBack(static_cast<T>((i * 37 + 11) % 100));
+    }
+    const T value = static_cast<T>(50);
+
+    T sum = 0;
+    T dot = 0;
+    size_t less = 0;
+    size_t equal = 0;
+    size_t first_equal = size;
+    for (size_t i = 0; i < size; ++i) {
+        sum += v[i];
+        dot += v[i] * v[i];
+        less += v[i] < value ? 1 : 0;
+        if (v[i] == value) {
+            ++equal;
+            first_equal = std::min(first_equal, i);
+        }
+    }
+
+    assert(SimdSum(v) == sum);
+    assert(SimdDot(v, v) == dot);
+    assert(SimdCount(v, SimdCompare::LESS, value) == less);
+    assert(SimdCount(v, SimdCompare::GREATER_EQUAL, value) == size - less);
+    assert(SimdCount(v, SimdCompare::EQUAL, value) == equal);
+    assert(SimdFind(v, SimdCompare::EQUAL, value) == first_equal);
+    assert(SimdFind(v, SimdCompare::GREATER, static_cast<T>(100)) == size);
+    if (size != 0) {
+        assert(SimdMin(v) == *std::min_element(v.begin(), v.end()));
+        assert(SimdMax(v) == *std::max_element(v.begin(), v.end()));
+    }
+
+    Vector<T> expected = v;
+    EraseIf(expected, [value](T x) { return x < value; });
+    assert(SimdEraseIf(v, SimdCompare::LESS, value) == less);
+    assert(v.Size() == expected.Size() && std::equal(v.begin(), v.end(), expected.begin()));
+}
+
+void Test27() {
+    const SimdLevel detected = GetSimdLevel();
+    for (SimdLevel level : {SimdLevel::SCALAR, SimdLevel::SSE2, SimdLevel::AVX2, SimdLevel::AVX512}) {
+        SetMaxSimdLevel(level);
+        assert(GetSimdLevel() <= level);
+        for (size_t size : {0, 1, 15, 64, 257, 1000}) {
+            CheckSimdAlgorithms<int8_t>(size);
+            CheckSimdAlgorithms<uint16_t>(size);
+            CheckSimdAlgorithms<int32_t>(size);
+            CheckSimdAlgorithms<uint64_t>(size);
+            CheckSimdAlgorithms<float>(size);
+            CheckSimdAlgorithms<double>(size);
+        }
+
+        // Счётчики в восьмибитных дорожках не переполняются
+        Vector<int8_t> bytes(100000);
+        bytes[99999] = 1;
+        assert(SimdCount(bytes, SimdCompare::EQUAL, int8_t{0}) == 99999);
+        assert(SimdFind(bytes, SimdCompare::NOT_EQUAL, int8_t{0}) == 99999);
+        assert(SimdEraseIf(bytes, SimdCompare::EQUAL, int8_t{0}) == 99999);
+        assert(bytes.Size() == 1 && bytes[0] == 1);
+
+        Vector<int> negative{-5, 3, -7, 2};
+        assert(SimdMin(negative) == -7 && SimdMax(negative) == 3);
+    }
+    SetMaxSimdLevel(SimdLevel::AVX512);
+    assert(GetSimdLevel() == detected);
+
+    // Указательные перегрузки подходят для других непрерывных контейнеров
+    SoaVector<float, int> soa;
+    for (int i = 0; i < 10; ++i) {
+        soa.EmplaceBack(1.5f, i);
+    }
+    assert(SimdSum(soa.Column<0>().Data(), soa.Size()) == 15.0f);
+    assert(SimdCount(soa.Column<1>().Data(), soa.Size(), SimdCompare::GREATER, 6) == 3);
+}
+
+void Test28() {
+    {
+        // Вложенные группы выполняются, пока внешние задачи ждут их завершения
+        ThreadPool pool(4);
+        std::atomic<int> counter = 0;
+        {
+            TaskGroup group(pool);
+            for (int i = 0; i < 64; ++i) {
+                group.Run([&pool, &counter] {
+                    TaskGroup inner(pool);
+                    for (int j = 0; j < 16; ++j) {
+                        inner.Run([&counter] {
+                            ++counter;
+                        });
+                    }
+                    inner.Wait();
+                });
+            }
+            group.Wait();
+        }
+        assert(counter == 64 * 16 && pool.ThreadCount() == 4);
+
+        TaskGroup failing(pool);
+        for (int i = 0; i < 8; ++i) {
+            failing.Run([i, &counter] {
+                if (i == 3) {
+                    throw std::runtime_error("task");
+                }
+                ++counter;
+            });
+        }
+        try {
+            failing.Wait();
+            assert(false);
+        } catch (const std::runtime_error&) {
+        }
+        assert(counter == 64 * 16 + 7);
+
+        // К возврату из Wait захваты всех задач уже уничтожены
+        struct SlowProbe {
+            explicit SlowProbe(std::atomic<int>& counter) : destroyed(&counter) {
+            }
+            ~SlowProbe() {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                ++*destroyed;
+            }
+
+            std::atomic<int>* destroyed;
+        };
+        std::atomic<int> destroyed = 0;
+        TaskGroup probes(pool);
+        for (int i = 0; i < 20; ++i) {
+            probes.Run([probe = std::make_shared<SlowProbe>(destroyed)] {
+                (void)probe;
+            });
+        }
+        probes.Wait();
+        assert(destroyed == 20);
+
+        // Ожидающий поток спит, пока задача группы выполняется в пуле, а не крутится на yield
+        const auto thread_cpu_time = [] {
+            timespec time{};
+            clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time);
+            return std::chrono::seconds(time.tv_sec) + std::chrono::nanoseconds(time.tv_nsec);
+        };
+        const auto cpu_before = thread_cpu_time();
+        TaskGroup sleeping(pool);
+        sleeping.Run([] {
+            std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        });
+        sleeping.Wait();
+        assert(thread_cpu_time() - cpu_before < std::chrono::milliseconds(50));
+    }
+
+    const ParallelTag policy{3, 1000};
+    std::mt19937_64 random(42);
+    {
+        Vector<uint64_t> v;
+        std::vector<uint64_t> expected;
+        for (int i = 0; i < 100000; ++i) {
+            v.PushBack(random());
+            expected.push_back(v[i]);
+        }
+        Sort(policy, v);
+        std::sort(expected.begin(), expected.end());
+        assert(std::equal(v.begin(), v.end(), expected.begin(), expected.end()));
+    }
+    {
+        // Устойчивость и отрицательные ключи
+        Vector<std::pair<int32_t, int>> v;
+        for (int i = 0; i < 50000; ++i) {
+            v.EmplaceBack(static_cast<int32_t>(random() % 2001) - 1000, i);
+        }
+        RadixSort(policy, v);
+        for (size_t i = 1; i < v.Size(); ++i) {
+            assert(v[i - 1].first < v[i].first || (v[i - 1].first == v[i].first && v[i - 1].second < v[i].second));
+        }
+        assert(v[0].first == -1000);
+    }
+    {
+        // Слияние нечётного числа серий
+        Vector<std::string> v;
+        std::vector<std::string> expected;
+        for (int i = 0; i < 20001; ++i) {
+            v.PushBack(std::to_string(random() % 5000));
+            expected.push_back(v[i]);
+        }
+        Sort(ParallelTag{5, 700}, v, std::greater<>());
+        std::sort(expected.begin(), expected.end(), std::greater<>());
+        assert(std::equal(v.begin(), v.end(), expected.begin(), expected.end()));
+
+        Vector<std::string> single{"b", "a"};
+        Sort(PARALLEL, single);
+        assert(single[0] == "a" && single[1] == "b");
+    }
+    {
+        Vector<int> v(10000);
+        Transform(policy, v, [](int) {
+            return 2;
+        });
+        assert(Reduce(policy, v, int64_t{5}) == 20005);
+
+        Vector<std::string> names;
+        Transform(policy, v, names, [](int x) {
+            return std::to_string(x);
+        });
+        assert(names.Size() == 10000 && names[9999] == "2");
+
+        const auto concat = [](std::string lhs, const std::string& rhs) {
+            return lhs + rhs;
+        };
+        Vector<std::string> letters{"a", "b", "c", "d"};
+        assert(Reduce(ParallelTag{2, 1}, letters, std::string(">"), concat) == ">abcd");
+        assert(Reduce(policy, Vector<int>(), 7) == 7);
+    }
+    {
+        // Разнородная операция: каждый элемент, включая первый в отрезке, проходит через op
+        struct Count {
+            size_t value = 0;
+        };
+        struct CountPositive {
+            Count operator()(Count count, int x) const {
+                return {count.value + (x > 0)};
+            }
+            Count operator()(Count lhs, Count rhs) const {
+                return {lhs.value + rhs.value};
+            }
+        };
+        Vector<int> v(1000);
+        Transform(policy, v, [](int) {
+            return 100;
+        });
+        assert(Reduce(ParallelTag{4, 1}, v, Count{5}, CountPositive()).value == 1005);
+
+        struct CountPositiveSize {
+            size_t operator()(size_t count, int x) const {
+                return count + (x > 0);
+            }
+            size_t operator()(size_t lhs, size_t rhs) const {
+                return lhs + rhs;
+            }
+        };
+        assert(Reduce(ParallelTag{4, 1}, v, size_t{0}, CountPositiveSize()) == 1000);
+
+        const auto product = [](int64_t lhs, int64_t rhs) {
+            return lhs * rhs;
+        };
+        Vector<int> factors(20);
+        Transform(policy, factors, [](int) {
+            return 2;
+        });
+        assert(Reduce(ParallelTag{4, 1}, factors, int64_t{3}, product, int64_t{1}) == (int64_t{3} << 20));
+    }
+}
+
+void Test29() {
+    {
+        SharedVector<std::string> v(Vector<std::string>{"a", "b", "c"});
+        SharedVector<std::string> copy = v;
+        assert(copy.Data() == v.Data() && v.UseCount() == 2 && v.IsShared());
+
+        // Первое изменение копирует буфер, исходный вектор не меняется
+        copy.PushBack("d");
+        assert(copy.Data() != v.Data() && !v.IsShared() && !copy.IsShared());
+        assert(v.Size() == 3 && copy.Size() == 4 && copy[3] == "d");
+
+        // Единоличный буфер меняется на месте
+        const std::string* data = copy.Data();
+        copy.Mutable()[0] = "z";
+        assert(copy.Data() == data && copy.At(0) == "z" && v[0] == "a");
+
+        const FrozenVector<std::string> frozen = v.Freeze();
+        FrozenVector<std::string> frozen_copy = frozen;
+        assert(frozen.Data() == v.Data() && v.UseCount() == 3);
+        v.Mutable()[1] = "x";
+        assert(frozen[1] == "b" && frozen_copy.UseCount() == 2 && v[1] == "x");
+
+        SharedVector<std::string> thawed(frozen);
+        assert(thawed.Data() == frozen.Data() && frozen.UseCount() == 3);
+
+        // Очистка разделяемого вектора только отпускает буфер
+        thawed.Clear();
+        assert(thawed.Empty() && thawed.UseCount() == 0 && frozen.UseCount() == 2);
+        thawed.EmplaceBack("new");
+        assert(thawed.Size() == 1 && thawed.UseCount() == 1);
+
+        std::string joined;
+        for (const std::string& s : frozen) {
+            joined += s;
+        }
+        assert(joined == "abc");
+        try {
+            frozen.At(3);
+            assert(false);
+        } catch (const std::out_of_range&) {
+        }
+    }
+    {
+        SharedVector<int> empty;
+        SharedVector<int> copy = empty;
+        assert(empty.Empty() && empty.UseCount() == 0 && empty.begin() == empty.end());
+        copy.Resize(3);
+        assert(copy.Size() == 3 && empty.Empty() && empty.Freeze().Empty());
+        copy.Swap(empty);
+        assert(empty.Size() == 3 && copy.Empty());
+    }
+    {
+        // При исключении во время копирования буфер остаётся разделяемым
+        Counted::throw_at = -1;
+        Vector<Counted> source(3);
+        SharedVector<Counted> v(std::move(source));
+        SharedVector<Counted> copy = v;
+        Counted::constructed = 0;
+        Counted::throw_at = 1;
+        try {
+            copy.PopBack();
+            assert(false);
+        } catch (const std::runtime_error&) {
+        }
+        Counted::throw_at = -1;
+        assert(copy.Data() == v.Data() && copy.Size() == 3 && Counted::alive == 3);
+    }
+    assert(Counted::alive == 0);
+    {
+        // Копии читаются и изменяются в разных потоках
+        SharedVector<int> base(Vector<int>(1000));
+        std::vector<std::thread> threads;
+        std::atomic<int> failures = 0;
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([base, t, &failures]() mutable {
+                const FrozenVector<int> snapshot = base.Freeze();
+                for (int i = 0; i < 100; ++i) {
+                    SharedVector<int> local = base;
+                    local.Mutable()[0] = t;
+                    if (local[0] != t || snapshot[0] != 0) {
+                        ++failures;
+                    }
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        assert(failures == 0 && base.UseCount() == 1 && base[0] == 0);
+    }
+}
+
+// Принимает представление без копирования элементов
+int SumSpan(Span<const int> span) {
+    int sum = 0;
+    for (int x : span) {
+        sum += x;
+    }
+    return sum;
+}
+
+void Test30() {
+    Vector<int> v{0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    Span<int> all = v.AsSpan();
+    assert(all.Data() == v.Data() && all.Size() == 10 && all.SizeBytes() == 10 * sizeof(int));
+    assert(SumSpan(all) == 45 && SumSpan(v.Subspan(2, 3)) == 9 && SumSpan(v.Subspan(7)) == 24);
+
+    // Представление ссылается на элементы вектора
+    v.Subspan(8)[0] = 80;
+    assert(v[8] == 80);
+    v[8] = 8;
+
+    const Span<int> middle = all.Subspan(3, 4);
+    assert(middle.Front() == 3 && middle.Back() == 6);
+    assert(middle.First(2).Back() == 4 && middle.Last(1).Front() == 6);
+    assert(middle.Subspan(4).Empty() && all.First(0).Empty());
+
+    const Vector<int>& cv = v;
+    Span<const int> const_span = cv.AsSpan();
+    Span<const int> converted = all;
+    assert(const_span.Data() == converted.Data());
+
+    // Чётные и нечётные элементы
+    StridedSpan<int> odd = v.Strided(1, 2);
+    assert(odd.Size() == 5 && odd[0] == 1 && odd[4] == 9 && odd.Stride() == 2);
+    for (int& x : odd) {
+        x = -x;
+    }
+    assert(v[3] == -3 && v[4] == 4);
+
+    StridedSpan<const int> even = cv.Strided(0, 2);
+    assert(even.Size() == 5 && std::accumulate(even.begin(), even.end(), 0) == 20);
+    assert(even.end() - even.begin() == 5 && *(even.begin() + 2) == 4 && even.begin()[4] == 8);
+    assert(even.Subspan(1, 2).Size() == 2 && even.Subspan(1, 2)[1] == 4);
+    assert(all.Strided(3).Size() == 4 && all.Strided(3)[3] == -9);
+    assert(v.Strided(10, 3).Empty());
+    // Смещение, равное размеру, не выводит указатель за конец буфера: 4 * 3 > 10
+    assert(all.Strided(3).Subspan(4).Empty() && all.Strided(3).Subspan(4).Data() == all.Data());
+    assert(all.Strided(3).Subspan(3).Size() == 1 && all.Strided(3).Subspan(3)[0] == -9);
+
+    std::vector<int> sorted(odd.begin(), odd.end());
+    std::sort(odd.begin(), odd.end());
+    assert(v[1] == -9 && v[9] == -1 && sorted.size() == 5);
+
+    // Столбец SoaVector - то же представление
+    SoaVector<int, double> soa;
+    soa.EmplaceBack(1, 0.5);
+    soa.EmplaceBack(2, 1.5);
+    Span<const int> column = std::as_const(soa).Column<0>();
+    assert(column.Size() == 2 && column[1] == 2);
+    assert(SimdSum(soa.Column<1>().Data(), soa.Column<1>().Size()) == 2.0);
+}
+
+#if defined(__cpp_lib_constexpr_dynamic_alloc) && __cpp_lib_constexpr_dynamic_alloc >= 201907L
+// Таблица строится при компиляции
+constexpr StaticVector<int, 16> MakeOddSquares() {
+    StaticVector<int, 16> table;
+    for (int i = 0; i < 10; ++i) {
+        table.PushBack(i * i);
+    }
+    table.Erase(std::remove_if(table.begin(), table.end(), [](int x) { return x % 2 == 0; }), table.end());
+    table.Insert(table.begin(), -1);
+    return table;
+}
+
+constexpr StaticVector<int, 16> ODD_SQUARES = MakeOddSquares();
+static_assert(ODD_SQUARES.Size() == 6 && ODD_SQUARES[0] == -1 && ODD_SQUARES.Back() == 81);
+#endif
+
+void Test31() {
+    {
+        StaticVector<std::string, 4> v{"b", "d"};
+        assert(v.Size() == 2 && v.Capacity() == 4 && !v.Full());
+        v.Insert(v.begin(), "a");
+        v.Emplace(v.begin() + 2, 1, 'c');
+        assert(v.Full() && v[0] == "a" && v[1] == "b" && v[2] == "c" && v[3] == "d");
+
+        // Память внутри объекта, добавление сверх ёмкости бросает исключение
+        assert(reinterpret_cast<const char*>(v.begin()) >= reinterpret_cast<const char*>(&v)
+               && reinterpret_cast<const char*>(v.end()) <= reinterpret_cast<const char*>(&v + 1));
+        try {
+            v.PushBack("e");
+            assert(false);
+        } catch (const std::length_error&) {
+        }
+        assert(v.Size() == 4);
+
+        assert(*v.Erase(v.begin() + 1) == "c" && v.Size() == 3);
+        assert(v.Erase(v.begin(), v.end()) == v.end() && v.Empty());
+
+        v.PushBack("x");
+        v.Insert(v.begin(), v[0]);
+        assert(v.Size() == 2 && v[0] == "x" && v[1] == "x");
+        try {
+            v.At(2);
+            assert(false);
+        } catch (const std::out_of_range&) {
+        }
+    }
+    {
+        StaticVector<std::string, 8> a{"1", "2", "3"};
+        StaticVector<std::string, 8> b(5);
+        assert(b.Size() == 5 && b[4].empty());
+
+        b = a;
+        assert(b.Size() == 3 && b[2] == "3");
+        a.PushBack("4");
+        b = std::move(a);
+        assert(b.Size() == 4 && b[3] == "4");
+
+        StaticVector<std::string, 8> c{"only"};
+        c.Swap(b);
+        assert(c.Size() == 4 && b.Size() == 1 && b[0] == "only" && c[0] == "1");
+
+        const StaticVector<std::string, 8> copy = c;
+        assert(std::equal(copy.begin(), copy.end(), c.begin(), c.end()) && *c.rbegin() == "4");
+        c.Resize(2);
+        c.PopBack();
+        c.Clear();
+        assert(c.Empty());
+    }
+    {
+        // Исключение при копировании уничтожает уже построенные элементы
+        Counted::throw_at = -1;
+        StaticVector<Counted, 4> v(3);
+        Counted::constructed = 0;
+        Counted::throw_at = 2;
+        try {
+            StaticVector<Counted, 4> copy = v;
+            assert(false);
+        } catch (const std::runtime_error&) {
+        }
+        Counted::throw_at = -1;
+        assert(Counted::alive == 3);
+    }
+    assert(Counted::alive == 0);
+}
+
+void Test32() {
+    {
+        Vector<int> v{1, 2};
+        v.AppendBatch(5, [](size_t i) {
+            return static_cast<int>(i * 10);
+        });
+        assert(v.Size() == 7 && v[2] == 0 && v[6] == 40);
+
+        // Генератор без аргументов читает очередное значение, как десериализатор
+        int next = 100;
+        v.AppendBatch(3, [&next] {
+            return next++;
+        });
+        assert(v.Size() == 10 && v[7] == 100 && v[9] == 102);
+
+        // Нулевая пачка ничего не меняет
+        const size_t capacity = v.Capacity();
+        v.AppendBatch(0, [](size_t) {
+            return 0;
+        });
+        assert(v.Size() == 10 && v.Capacity() == capacity);
+    }
+    {
+        Vector<std::string> v;
+        v.AppendBatch(100, [](size_t i) {
+            return std::to_string(i);
+        });
+        assert(v.Size() == 100 && v[0] == "0" && v[99] == "99");
+    }
+    {
+        // Исключение посреди пачки откатывает все её элементы
+        Vector<Counted> v(2);
+        Counted::constructed = 0;
+        Counted::throw_at = 3;
+        try {
+            v.AppendBatch(5, [] {
+                return Counted{};
+            });
+            assert(false);
+        } catch (const std::runtime_error&) {
+        }
+        Counted::throw_at = -1;
+        assert(v.Size() == 2 && Counted::alive == 2);
+    }
+    assert(Counted::alive == 0);
+    {
+        Vector<std::pair<int, std::string>> v;
+        v.Reserve(3);
+        for (int i = 0; i < 3; ++i) {
+            v.EmplaceBackUnchecked(i, std::string(2, 'a'));
+        }
+        assert(v.Size() == 3 && v.Back().first == 2 && v.Back().second == "aa");
+    }
+}
+
+#ifdef ADVANCED_VECTOR_CHECKED
+struct CheckFailure : std::logic_error {
+    using std::logic_error::logic_error;
+};
+
+void ThrowCheckFailure(const char* message) {
+    throw CheckFailure(message);
+}
+
+// Проверяемый режим обнаружил нарушение при выполнении operation
+template <typename Operation>
+bool DetectsViolation(Operation operation) {
+    try {
+        operation();
+    } catch (const CheckFailure&) {
+        return true;
+    }
+    return false;
+}
+#endif
+
+void Test33() {
+    {
+        Vector<int> v{1, 2, 3};
+        const Vector<int>& const_v = v;
+        try {
+            v.At(3);
+            assert(false);
+        } catch (const std::out_of_range&) {
+        }
+        try {
+            const_v.At(10);
+            assert(false);
+        } catch (const std::out_of_range&) {
+        }
+        assert(const_v.At(2) == 3 && const_v.Data() == &v[0]);
+    }
+#ifdef ADVANCED_VECTOR_CHECKED
+    const CheckFailureHandler previous = SetCheckFailureHandler(&ThrowCheckFailure);
+    {
+        Vector<int> v{1, 2, 3};
+        auto stale = v.begin() + 1;
+        // Вектор из списка инициализации заполнен целиком, поэтому вставка перераспределяет буфер
+        v.PushBack(4);
+        assert(DetectsViolation([&] {
+            return *stale;
+        }));
+        assert(DetectsViolation([&] {
+            v.Insert(stale, 0);
+        }));
+        assert(v.Size() == 4 && *(v.begin() + 1) == 2);
+
+        assert(DetectsViolation([&] {
+            return v[4];
+        }));
+        assert(DetectsViolation([&] {
+            return *v.end();
+        }));
+        assert(DetectsViolation([&] {
+            return v.begin() - 1;
+        }));
+
+        // Удаление не перераспределяет буфер, но итератор за новым концом разыменовывать нельзя
+        auto last = v.end() - 1;
+        auto old_end = v.end();
+        v.PopBack();
+        assert(DetectsViolation([&] {
+            return *last;
+        }));
+        assert(DetectsViolation([&] {
+            v.Insert(old_end, 0);
+        }));
+
+        Vector<int> other{1};
+        assert(DetectsViolation([&] {
+            return v.begin() == other.begin();
+        }));
+        assert(DetectsViolation([&] {
+            v.Erase(other.begin());
+        }));
+
+        Vector<int> empty;
+        assert(DetectsViolation([&] {
+            empty.PopBack();
+        }));
+        assert(DetectsViolation([&] {
+            return empty.Back();
+        }));
+        assert(DetectsViolation([] {
+            return *Vector<int>::iterator{};
+        }));
+    }
+    {
+        // Итераторы следуют за буфером при перемещении и обмене
+        Vector<std::string> v{"a", "b"};
+        auto it = v.begin();
+        Vector<std::string> moved = std::move(v);
+        assert(*it == "a" && it == moved.begin());
+
+        Vector<std::string> w{"z"};
+        auto w_it = w.begin();
+        moved.Swap(w);
+        assert(*w_it == "z" && w_it == moved.begin() && *it == "a" && it == w.begin());
+
+        Vector<std::string>::iterator dangling;
+        {
+            Vector<std::string> temp{"x"};
+            dangling = temp.begin();
+        }
+        assert(DetectsViolation([&] {
+            return *dangling;
+        }));
+    }
+    {
+        // Первый обход константного вектора из нескольких потоков создаёт общее состояние итераторов
+        Vector<int> source;
+        source.AppendBatch(1000, [] {
+            return 1;
+        });
+        const Vector<int>& v = source;
+        std::atomic<int> total{0};
+        std::vector<std::thread> readers;
+        for (int i = 0; i < 4; ++i) {
+            readers.emplace_back([&] {
+                int sum = 0;
+                for (int x : v) {
+                    sum += x;
+                }
+                total += sum;
+            });
+        }
+        for (std::thread& reader : readers) {
+            reader.join();
+        }
+        assert(total == 4000);
+    }
+    SetCheckFailureHandler(previous);
+#endif
+}
+
+struct IngestBuffers {
+    static constexpr const char* NAME = "ingest";
+};
+
+void Test34() {
+    using Stats = AccountingVectorStats<IngestBuffers>;
+    using IngestVector = Vector<int64_t, std::allocator<int64_t>, DoublingGrowth, Stats>;
+    static_assert(sizeof(IngestVector) == sizeof(Vector<int64_t>));
+    {
+        IngestVector v;
+        v.Reserve(100);
+        v.AppendBatch(10, [](size_t i) {
+            return static_cast<int64_t>(i);
+        });
+
+        VectorMemoryReport report = Stats::Get();
+        assert(std::string(report.name) == "ingest");
+        assert(report.live_buffers == 1 && report.live_bytes == v.Capacity() * sizeof(int64_t));
+        assert(report.used_bytes == 10 * sizeof(int64_t));
+        assert(report.slack_bytes == (v.Capacity() - 10) * sizeof(int64_t));
+
+        // Копия и перемещённый вектор учитываются как отдельный живой буфер
+        IngestVector copy = v;
+        IngestVector moved = std::move(copy);
+        report = Stats::Get();
+        assert(report.live_buffers == 2 && report.used_bytes == 20 * sizeof(int64_t));
+
+        v.ShrinkToFit();
+        report = Stats::Get();
+        assert(report.live_bytes == (v.Capacity() + moved.Capacity()) * sizeof(int64_t));
+        assert(report.slack_bytes == (v.Capacity() + moved.Capacity() - 20) * sizeof(int64_t));
+
+        // Буфер, отданный через Release, выходит из учёта и возвращается через Adopt
+        VectorBuffer<int64_t> buffer = moved.Release();
+        report = Stats::Get();
+        assert(report.live_buffers == 1 && report.used_bytes == 10 * sizeof(int64_t));
+        moved.Adopt(buffer);
+        moved.PopBack();
+        moved.Erase(moved.begin(), moved.begin() + 2);
+        assert(Stats::Get().used_bytes == 17 * sizeof(int64_t));
+
+        v.Swap(moved);
+        v.Clear();
+        report = Stats::Get();
+        assert(report.live_buffers == 2 && report.used_bytes == 10 * sizeof(int64_t));
+    }
+    VectorMemoryReport report = Stats::Get();
+    assert(report.live_buffers == 0 && report.live_bytes == 0 && report.used_bytes == 0);
+    assert(report.peak_live_bytes >= 100 * sizeof(int64_t));
+    {
+        const size_t reallocations = Stats::Get().reallocations;
+        IngestVector v;
+        for (int64_t i = 0; i < 16; ++i) {
+            v.PushBack(i);
+        }
+        // Ёмкости 1, 2, 4, 8, 16
+        assert(Stats::Get().reallocations == reallocations + 4);
+    }
+
+    bool found = false;
+    ForEachVectorMemoryReport([&found](const VectorMemoryReport& entry) {
+        if (std::string(entry.name) == "ingest") {
+            found = entry.live_buffers == 0 && entry.allocations != 0;
+        }
+    });
+    assert(found);
+}
+
+void Test35() {
+    // Обход указателей с предвыборкой: порядок и результат не зависят от distance
+    {
+        Vector<std::unique_ptr<int>> owners;
+        Vector<const int*> pointers;
+        for (int i = 0; i < 100; ++i) {
+            owners.EmplaceBack(std::make_unique<int>(i));
+            pointers.PushBack(owners[i].get());
+        }
+        for (size_t distance : {size_t{0}, size_t{1}, size_t{8}, size_t{100}, size_t{1000}}) {
+            int expected = 0;
+            ForEachPrefetched(pointers, distance, [&expected](const int* value) {
+                assert(*value == expected);
+                ++expected;
+            });
+            assert(expected == 100);
+
+            int sum = 0;
+            ForEachPrefetched(owners, distance, [&sum](std::unique_ptr<int>& value) {
+                sum += *value;
+            });
+            assert(sum == 99 * 100 / 2);
+        }
+
+        // Собственная проекция адреса и обход константного вектора
+        const Vector<std::unique_ptr<int>>& view = owners;
+        size_t visited = 0;
+        ForEachPrefetched(view, 4, [&visited](const std::unique_ptr<int>&) {
+            ++visited;
+        }, [](const std::unique_ptr<int>& value) -> const void* {
+            return value.get();
+        });
+        assert(visited == owners.Size());
+
+        Vector<int*> empty;
+        ForEachPrefetched(empty, 8, [](int*) {
+            assert(false);
+        });
+    }
+    // Блочный обход: полные блоки по chunk_bytes и укороченный последний
+    {
+        Vector<int64_t> v;
+        v.AppendBatch(1000, [](size_t i) {
+            return static_cast<int64_t>(i);
+        });
+        Vector<size_t> sizes;
+        int64_t next = 0;
+        ForEachChunk(v, 64 * sizeof(int64_t), [&](Span<int64_t> chunk) {
+            sizes.PushBack(chunk.Size());
+            for (int64_t& value : chunk) {
+                assert(value == next);
+                ++next;
+                value *= 2;
+            }
+        });
+        assert(next == 1000);
+        assert(sizes.Size() == 16 && sizes[0] == 64 && sizes[15] == 1000 - 15 * 64);
+        assert(v[999] == 1998);
+
+        // Блок меньше элемента округляется до одного элемента
+        size_t chunks = 0;
+        const Vector<int64_t>& view = v;
+        ForEachChunk(view, 1, [&chunks](Span<const int64_t> chunk) {
+            assert(chunk.Size() == 1);
+            ++chunks;
+        });
+        assert(chunks == 1000);
+
+        int64_t sum = 0;
+        ForEachChunk(v, L1_BLOCK_BYTES, [&sum](Span<int64_t> chunk) {
+            sum = std::accumulate(chunk.begin(), chunk.end(), sum);
+        });
+        assert(sum == 999 * 1000);
+
+        Vector<int64_t> empty;
+        ForEachChunk(empty, L2_BLOCK_BYTES, [](Span<int64_t>) {
+            assert(false);
+        });
     }
 }
 
@@ -660,8 +2605,37 @@ int main() {
         Test4();
         Test5();
         Test6();
-        Benchmark();
+        Test7();
+        Test8();
+        Test9();
+        Test10();
+        Test11();
+        Test12();
+        Test13();
+        Test14();
+        Test15();
+        Test16();
+        Test17();
+        Test18();
+        Test19();
+        Test20();
+        Test21();
+        Test22();
+        Test23();
+        Test24();
+        Test25();
+        Test26();
+        Test27();
+        Test28();
+        Test29();
+        Test30();
+        Test31();
+        Test32();
+        Test33();
+        Test34();
+        Test35();
     } catch (const std::exception& e) {
         std::cerr << e.what() << std::endl;
+        return 1;
     }
 }
\ No newline at end of file
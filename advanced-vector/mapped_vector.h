@@ -0,0 +1,421 @@
+#pragma once
+
+#include "growth_policy.h"
+
+#include <cassert>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+enum class MappedVectorMode {
+    READ_ONLY,   // файл должен существовать, изменять вектор нельзя
+    READ_WRITE,  // файл должен существовать
+    CREATE,      // файл создаётся заново, прежнее содержимое удаляется
+};
+
+// Заголовок в начале файла. Его размер кратен кэш-линии, поэтому данные выровнены
+// для любого T с alignof(T) <= 64
+struct MappedVectorHeader {
+    static constexpr uint64_t MAGIC = 0x31524556'44505041;  // "APPDVER1"
+    static constexpr uint32_t VERSION = 1;
+
+    uint64_t magic = MAGIC;
+    uint32_t version = VERSION;
+    uint32_t element_size = 0;
+    uint64_t size = 0;
+    uint64_t capacity = 0;
+    std::byte reserved[32] = {};
+};
+
+// Вектор, элементы которого лежат в файле, отображённом в память через MAP_SHARED.
+// Открытие файла не читает данные: страницы подгружаются по первому обращению и
+// разделяются через page cache между всеми процессами, открывшими тот же файл.
+// Рост выполняется через ftruncate и mremap без копирования элементов.
+// Одновременная запись в один файл из нескольких процессов не поддерживается
+template <typename T, typename GrowthPolicy = DoublingGrowth>
+class MappedVector {
+    static_assert(std::is_trivially_copyable_v<T>, "MappedVector stores elements as raw bytes");
+    static_assert(alignof(T) <= sizeof(MappedVectorHeader), "elements must stay aligned after the header");
+
+public:
+    using value_type = T;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    MappedVector() = default;
+    // Бросает std::system_error при ошибке ввода-вывода и std::runtime_error, если
+    // файл не является вектором элементов размером sizeof(T)
+    explicit MappedVector(const std::string& path, MappedVectorMode mode = MappedVectorMode::READ_WRITE);
+    ~MappedVector();
+
+    MappedVector(const MappedVector&) = delete;
+    MappedVector& operator=(const MappedVector&) = delete;
+
+    MappedVector(MappedVector&& other) noexcept;
+    MappedVector& operator=(MappedVector&& other) noexcept;
+
+    const T& operator[](size_t index) const noexcept;
+    T& operator[](size_t index) noexcept;
+
+    iterator begin() noexcept;
+    iterator end() noexcept;
+    const_iterator begin() const noexcept;
+    const_iterator end() const noexcept;
+    const_iterator cbegin() const noexcept;
+    const_iterator cend() const noexcept;
+
+    size_t Size() const noexcept;
+    size_t Capacity() const noexcept;
+    bool Empty() const noexcept;
+    bool IsOpen() const noexcept;
+    bool IsWritable() const noexcept;
+
+    template <typename... Args>
+    T& EmplaceBack(Args&&... args);
+    void PushBack(const T& value);
+    void PopBack() noexcept;
+
+    void Reserve(size_t new_capacity);
+    void Resize(size_t new_size);
+    // Обрезает файл до Size() элементов
+    void ShrinkToFit();
+
+    // Дожидается записи изменённых страниц на диск
+    void Sync();
+    void Close() noexcept;
+
+    void Swap(MappedVector& other) noexcept;
+
+private:
+    static constexpr size_t HEADER_SIZE = sizeof(MappedVectorHeader);
+
+    int fd_ = -1;
+    std::byte* mapping_ = nullptr;
+    size_t mapped_bytes_ = 0;
+    bool writable_ = false;
+
+    MappedVectorHeader& Header() noexcept;
+    const MappedVectorHeader& Header() const noexcept;
+    T* Data() noexcept;
+    const T* Data() const noexcept;
+
+    static size_t FileBytes(size_t capacity);
+
+    void Map(size_t bytes);
+    // Изменяет длину файла и отображения под new_capacity элементов
+    void Remap(size_t new_capacity);
+};
+
+//-------------------------MAPPED_VECTOR---------------------
+template <typename T, typename GrowthPolicy>
+inline MappedVector<T, GrowthPolicy>::MappedVector(const std::string& path, MappedVectorMode mode)
+    : writable_(mode != MappedVectorMode::READ_ONLY) {
+    const int flags = mode == MappedVectorMode::READ_ONLY ? O_RDONLY
+                    : mode == MappedVectorMode::CREATE    ? O_RDWR | O_CREAT | O_TRUNC
+                                                          : O_RDWR;
+    fd_ = ::open(path.c_str(), flags | O_CLOEXEC, 0644);
+    if (fd_ < 0) {
+        throw std::system_error(errno, std::generic_category(), "open " + path);
+    }
+
+    try {
+        if (mode == MappedVectorMode::CREATE) {
+            const MappedVectorHeader header{MappedVectorHeader::MAGIC, MappedVectorHeader::VERSION,
+                                            static_cast<uint32_t>(sizeof(T))};
+            if (::pwrite(fd_, &header, HEADER_SIZE, 0) != static_cast<ssize_t>(HEADER_SIZE)) {
+                throw std::system_error(errno, std::generic_category(), "write " + path);
+            }
+        }
+
+        struct stat file_stat {};
+        if (::fstat(fd_, &file_stat) != 0) {
+            throw std::system_error(errno, std::generic_category(), "stat " + path);
+        }
+        if (static_cast<size_t>(file_stat.st_size) < HEADER_SIZE) {
+            throw std::runtime_error(path + ": file is too short for a MappedVector header");
+        }
+
+        MappedVectorHeader header;
+        if (::pread(fd_, &header, HEADER_SIZE, 0) != static_cast<ssize_t>(HEADER_SIZE)) {
+            throw std::system_error(errno, std::generic_category(), "read " + path);
+        }
+        if (header.magic != MappedVectorHeader::MAGIC || header.version != MappedVectorHeader::VERSION) {
+            throw std::runtime_error(path + ": not a MappedVector file");
+        }
+        if (header.element_size != sizeof(T)) {
+            throw std::runtime_error(path + ": element size mismatch");
+        }
+        if (header.size > header.capacity
+            || header.capacity > (static_cast<size_t>(file_stat.st_size) - HEADER_SIZE) / sizeof(T)) {
+            throw std::runtime_error(path + ": file is truncated");
+        }
+
+        Map(FileBytes(header.capacity));
+    } catch (...) {
+        ::close(fd_);
+        throw;
+    }
+}
+
+template <typename T, typename GrowthPolicy>
+inline MappedVector<T, GrowthPolicy>::~MappedVector() {
+    Close();
+}
+
+template <typename T, typename GrowthPolicy>
+inline MappedVector<T, GrowthPolicy>::MappedVector(MappedVector&& other) noexcept {
+    Swap(other);
+}
+
+template <typename T, typename GrowthPolicy>
+inline MappedVector<T, GrowthPolicy>& MappedVector<T, GrowthPolicy>::operator=(MappedVector&& other) noexcept {
+    if (this != &other) {
+        Close();
+        Swap(other);
+    }
+    return *this;
+}
+
+template <typename T, typename GrowthPolicy>
+inline const T& MappedVector<T, GrowthPolicy>::operator[](size_t index) const noexcept {
+    assert(index < Size());
+    return Data()[index];
+}
+
+template <typename T, typename GrowthPolicy>
+inline T& MappedVector<T, GrowthPolicy>::operator[](size_t index) noexcept {
+    assert(index < Size());
+    return Data()[index];
+}
+
+template <typename T, typename GrowthPolicy>
+inline typename MappedVector<T, GrowthPolicy>::iterator MappedVector<T, GrowthPolicy>::begin() noexcept {
+    return Data();
+}
+
+template <typename T, typename GrowthPolicy>
+inline typename MappedVector<T, GrowthPolicy>::iterator MappedVector<T, GrowthPolicy>::end() noexcept {
+    return Data() + Size();
+}
+
+template <typename T, typename GrowthPolicy>
+inline typename MappedVector<T, GrowthPolicy>::const_iterator MappedVector<T, GrowthPolicy>::begin() const noexcept {
+    return Data();
+}
+
+template <typename T, typename GrowthPolicy>
+inline typename MappedVector<T, GrowthPolicy>::const_iterator MappedVector<T, GrowthPolicy>::end() const noexcept {
+    return Data() + Size();
+}
+
+template <typename T, typename GrowthPolicy>
+inline typename MappedVector<T, GrowthPolicy>::const_iterator MappedVector<T, GrowthPolicy>::cbegin() const noexcept {
+    return begin();
+}
+
+template <typename T, typename GrowthPolicy>
+inline typename MappedVector<T, GrowthPolicy>::const_iterator MappedVector<T, GrowthPolicy>::cend() const noexcept {
+    return end();
+}
+
+template <typename T, typename GrowthPolicy>
+inline size_t MappedVector<T, GrowthPolicy>::Size() const noexcept {
+    return IsOpen() ? static_cast<size_t>(Header().size) : 0;
+}
+
+template <typename T, typename GrowthPolicy>
+inline size_t MappedVector<T, GrowthPolicy>::Capacity() const noexcept {
+    return IsOpen() ? static_cast<size_t>(Header().capacity) : 0;
+}
+
+template <typename T, typename GrowthPolicy>
+inline bool MappedVector<T, GrowthPolicy>::Empty() const noexcept {
+    return Size() == 0;
+}
+
+template <typename T, typename GrowthPolicy>
+inline bool MappedVector<T, GrowthPolicy>::IsOpen() const noexcept {
+    return mapping_ != nullptr;
+}
+
+template <typename T, typename GrowthPolicy>
+inline bool MappedVector<T, GrowthPolicy>::IsWritable() const noexcept {
+    return IsOpen() && writable_;
+}
+
+template <typename T, typename GrowthPolicy>
+template <typename... Args>
+inline T& MappedVector<T, GrowthPolicy>::EmplaceBack(Args&&... args) {
+    assert(IsWritable());
+
+    // Аргументы могут ссылаться на элементы вектора, а mremap переносит отображение
+    const T value(std::forward<Args>(args)...);
+    const size_t size = Size();
+    if (size == Capacity()) {
+        Remap(GrowthPolicy::NextCapacity(Capacity(), size + 1, sizeof(T)));
+    }
+
+    T* slot = new (Data() + size) T(value);
+    Header().size = size + 1;
+    return *slot;
+}
+
+template <typename T, typename GrowthPolicy>
+inline void MappedVector<T, GrowthPolicy>::PushBack(const T& value) {
+    EmplaceBack(value);
+}
+
+template <typename T, typename GrowthPolicy>
+inline void MappedVector<T, GrowthPolicy>::PopBack() noexcept {
+    assert(IsWritable() && !Empty());
+    --Header().size;
+}
+
+template <typename T, typename GrowthPolicy>
+inline void MappedVector<T, GrowthPolicy>::Reserve(size_t new_capacity) {
+    assert(IsWritable());
+
+    if (new_capacity > Capacity()) {
+        Remap(new_capacity);
+    }
+}
+
+template <typename T, typename GrowthPolicy>
+inline void MappedVector<T, GrowthPolicy>::Resize(size_t new_size) {
+    assert(IsWritable());
+
+    const size_t size = Size();
+    if (new_size > size) {
+        Reserve(new_size);
+        // Новые страницы файла уже заполнены нулями, но освобождённые PopBack элементы - нет
+        std::memset(static_cast<void*>(Data() + size), 0, (new_size - size) * sizeof(T));
+    }
+    Header().size = new_size;
+}
+
+template <typename T, typename GrowthPolicy>
+inline void MappedVector<T, GrowthPolicy>::ShrinkToFit() {
+    assert(IsWritable());
+
+    if (Size() != Capacity()) {
+        Remap(Size());
+    }
+}
+
+template <typename T, typename GrowthPolicy>
+inline void MappedVector<T, GrowthPolicy>::Sync() {
+    assert(IsOpen());
+
+    if (::msync(mapping_, mapped_bytes_, MS_SYNC) != 0) {
+        throw std::system_error(errno, std::generic_category(), "msync");
+    }
+}
+
+template <typename T, typename GrowthPolicy>
+inline void MappedVector<T, GrowthPolicy>::Close() noexcept {
+    if (mapping_ != nullptr) {
+        ::munmap(mapping_, mapped_bytes_);
+        mapping_ = nullptr;
+        mapped_bytes_ = 0;
+    }
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+}
+
+template <typename T, typename GrowthPolicy>
+inline void MappedVector<T, GrowthPolicy>::Swap(MappedVector& other) noexcept {
+    std::swap(fd_, other.fd_);
+    std::swap(mapping_, other.mapping_);
+    std::swap(mapped_bytes_, other.mapped_bytes_);
+    std::swap(writable_, other.writable_);
+}
+
+template <typename T, typename GrowthPolicy>
+inline MappedVectorHeader& MappedVector<T, GrowthPolicy>::Header() noexcept {
+    return *reinterpret_cast<MappedVectorHeader*>(mapping_);
+}
+
+template <typename T, typename GrowthPolicy>
+inline const MappedVectorHeader& MappedVector<T, GrowthPolicy>::Header() const noexcept {
+    return *reinterpret_cast<const MappedVectorHeader*>(mapping_);
+}
+
+template <typename T, typename GrowthPolicy>
+inline T* MappedVector<T, GrowthPolicy>::Data() noexcept {
+    return mapping_ != nullptr ? reinterpret_cast<T*>(mapping_ + HEADER_SIZE) : nullptr;
+}
+
+template <typename T, typename GrowthPolicy>
+inline const T* MappedVector<T, GrowthPolicy>::Data() const noexcept {
+    return mapping_ != nullptr ? reinterpret_cast<const T*>(mapping_ + HEADER_SIZE) : nullptr;
+}
+
+template <typename T, typename GrowthPolicy>
+inline size_t MappedVector<T, GrowthPolicy>::FileBytes(size_t capacity) {
+    if (capacity > (static_cast<size_t>(-1) - HEADER_SIZE) / sizeof(T)) {
+        throw std::bad_alloc();
+    }
+    return HEADER_SIZE + capacity * sizeof(T);
+}
+
+template <typename T, typename GrowthPolicy>
+inline void MappedVector<T, GrowthPolicy>::Map(size_t bytes) {
+    const int protection = writable_ ? PROT_READ | PROT_WRITE : PROT_READ;
+    void* mapping = ::mmap(nullptr, bytes, protection, MAP_SHARED, fd_, 0);
+    if (mapping == MAP_FAILED) {
+        throw std::system_error(errno, std::generic_category(), "mmap");
+    }
+
+    mapping_ = static_cast<std::byte*>(mapping);
+    mapped_bytes_ = bytes;
+}
+
+template <typename T, typename GrowthPolicy>
+inline void MappedVector<T, GrowthPolicy>::Remap(size_t new_capacity) {
+    const size_t new_bytes = FileBytes(new_capacity);
+    const bool grows = new_bytes > mapped_bytes_;
+
+    // При росте файл удлиняется до отображения страниц, при сжатии - обрезается после
+    if (grows && ::ftruncate(fd_, static_cast<off_t>(new_bytes)) != 0) {
+        throw std::system_error(errno, std::generic_category(), "ftruncate");
+    }
+
+#if defined(__linux__)
+    void* mapping = ::mremap(mapping_, mapped_bytes_, new_bytes, MREMAP_MAYMOVE);
+    if (mapping == MAP_FAILED) {
+        throw std::system_error(errno, std::generic_category(), "mremap");
+    }
+    mapping_ = static_cast<std::byte*>(mapping);
+    mapped_bytes_ = new_bytes;
+#else
+    // Без mremap файл отображается заново; элементы остаются в файле и не копируются
+    void* mapping = ::mmap(nullptr, new_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+    if (mapping == MAP_FAILED) {
+        throw std::system_error(errno, std::generic_category(), "mmap");
+    }
+    ::munmap(mapping_, mapped_bytes_);
+    mapping_ = static_cast<std::byte*>(mapping);
+    mapped_bytes_ = new_bytes;
+#endif
+
+    Header().capacity = new_capacity;
+
+    if (!grows && ::ftruncate(fd_, static_cast<off_t>(new_bytes)) != 0) {
+        throw std::system_error(errno, std::generic_category(), "ftruncate");
+    }
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <thread>
+
+// Тег параллельного конструирования элементов. Отрезки буфера строятся в отдельных
+// потоках, поэтому каждый поток первым касается своих страниц и они распределяются
+// по узлам NUMA, на которых работают потоки
+struct ParallelTag {
+    size_t threads = 0;    // 0 - std::thread::hardware_concurrency()
+    size_t min_chunk = 0;  // наименьшее число элементов на поток; 0 - 256 КиБ элементов
+};
+
+inline constexpr ParallelTag PARALLEL{};
+
+// Вызывает construct(begin, end) для непересекающихся отрезков [0, count) в нескольких
+// потоках, один из отрезков - в вызывающем потоке. Как и std::uninitialized_*, construct
+// при исключении сам уничтожает построенную им часть отрезка. Если какой-либо отрезок
+// завершился исключением, для остальных построенных отрезков вызывается destroy(begin, end),
+// после чего первое исключение пробрасывается дальше
+template <typename Construct, typename Destroy>
+void ParallelConstruct(ParallelTag policy, size_t count, size_t element_size, Construct construct, Destroy destroy);
+
+//-------------------------PARALLEL---------------------
+namespace parallel_detail {
+
+inline size_t ChunkCount(ParallelTag policy, size_t count, size_t element_size) noexcept {
+    const size_t threads = policy.threads != 0 ? policy.threads
+                                               : std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    const size_t min_chunk = policy.min_chunk != 0 ? policy.min_chunk
+                                                   : std::max<size_t>((size_t(256) << 10) / element_size, 1);
+    return std::clamp<size_t>(count / min_chunk, 1, threads);
+}
+
+// Начало отрезка index при делении count элементов на chunks почти равных отрезков
+inline size_t ChunkBegin(size_t count, size_t chunks, size_t index) noexcept {
+    return count / chunks * index + std::min(index, count % chunks);
+}
+
+}  // namespace parallel_detail
+
+template <typename Construct, typename Destroy>
+inline void ParallelConstruct(ParallelTag policy, size_t count, size_t element_size, Construct construct, Destroy destroy) {
+    using parallel_detail::ChunkBegin;
+
+    const size_t chunks = parallel_detail::ChunkCount(policy, count, element_size);
+    if (chunks == 1) {
+        construct(size_t(0), count);
+        return;
+    }
+
+    auto errors = std::make_unique<std::exception_ptr[]>(chunks);
+    auto workers = std::make_unique<std::thread[]>(chunks);
+
+    auto run = [&](size_t index) noexcept {
+        try {
+            construct(ChunkBegin(count, chunks, index), ChunkBegin(count, chunks, index + 1));
+        } catch (...) {
+            errors[index] = std::current_exception();
+        }
+    };
+
+    for (size_t i = 1; i < chunks; ++i) {
+        try {
+            workers[i] = std::thread(run, i);
+        } catch (...) {
+            // Поток не удалось создать: отрезок строится в вызывающем потоке
+            run(i);
+        }
+    }
+    run(0);
+
+    for (size_t i = 1; i < chunks; ++i) {
+        if (workers[i].joinable()) {
+            workers[i].join();
+        }
+    }
+
+    const auto failed = std::find_if(errors.get(), errors.get() + chunks, [](const std::exception_ptr& error) {
+        return error != nullptr;
+    });
+    if (failed == errors.get() + chunks) {
+        return;
+    }
+
+    for (size_t i = 0; i < chunks; ++i) {
+        if (errors[i] == nullptr) {
+            destroy(ChunkBegin(count, chunks, i), ChunkBegin(count, chunks, i + 1));
+        }
+    }
+    std::rethrow_exception(*failed);
+}
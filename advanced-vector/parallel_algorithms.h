@@ -0,0 +1,355 @@
+#pragma once
+
+#include "parallel.h"
+#include "thread_pool.h"
+#include "vector.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+// Параллельные сортировка, преобразование и свёртка элементов Vector. Работа делится на
+// отрезки по ParallelTag (threads ограничивает число отрезков, min_chunk - их наименьший
+// размер) и выполняется в DefaultThreadPool(). При исключении из операции или из
+// перемещения элементов оно пробрасывается вызывающему коду после завершения остальных
+// отрезков, а элементы остаются в корректном, но неопределённом состоянии
+
+// Ключ поразрядной сортировки по умолчанию: само целое значение или поле first пары
+struct RadixKey {
+    template <typename T>
+    auto operator()(const T& value) const noexcept {
+        if constexpr (std::is_integral_v<T>) {
+            return value;
+        } else {
+            return value.first;
+        }
+    }
+};
+
+// Сортирует отрезки независимо и сливает их попарно, разбивая каждое слияние на части.
+// Целые числа со сравнением std::less сортируются поразрядно
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy, typename Compare = std::less<>>
+void Sort(ParallelTag policy, Vector<T, Allocator, GrowthPolicy, StatsPolicy>& v, Compare comp = Compare());
+
+// Устойчивая поразрядная сортировка по целому ключу key_of(element), по байту за проход.
+// Проходы, в которых у всех ключей одинаковый байт, пропускаются
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy, typename KeyOf = RadixKey>
+void RadixSort(ParallelTag policy, Vector<T, Allocator, GrowthPolicy, StatsPolicy>& v, KeyOf key_of = KeyOf());
+
+// v[i] = op(v[i])
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy, typename UnaryOperation>
+void Transform(ParallelTag policy, Vector<T, Allocator, GrowthPolicy, StatsPolicy>& v, UnaryOperation op);
+
+// Приводит размер dst к размеру src и записывает dst[i] = op(src[i])
+template <typename T, typename AllocatorSrc, typename GrowthPolicySrc, typename StatsPolicySrc,
+          typename U, typename AllocatorDst, typename GrowthPolicyDst, typename StatsPolicyDst, typename UnaryOperation>
+void Transform(ParallelTag policy, const Vector<T, AllocatorSrc, GrowthPolicySrc, StatsPolicySrc>& src,
+               Vector<U, AllocatorDst, GrowthPolicyDst, StatsPolicyDst>& dst, UnaryOperation op);
+
+// Сворачивает элементы в порядке отрезков: op должна быть ассоциативной и принимать
+// пары (Value, T) и (Value, Value). Первый отрезок сворачивается от init, остальные - от копий
+// identity, нейтрального элемента op: Value() подходит для сложения, подсчёта и конкатенации,
+// для умножения и других операций его нужно передать явно
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy, typename Value,
+          typename BinaryOperation = std::plus<>>
+Value Reduce(ParallelTag policy, const Vector<T, Allocator, GrowthPolicy, StatsPolicy>& v, Value init,
+             BinaryOperation op = BinaryOperation(), Value identity = Value());
+
+//-------------------------PARALLEL_ALGORITHMS---------------------
+namespace parallel_detail {
+
+// Вызывает body(index) для index из [0, chunks) в пуле, отрезок 0 - в вызывающем потоке
+template <typename Body>
+inline void RunChunks(size_t chunks, Body& body) {
+    if (chunks == 1) {
+        body(size_t(0));
+        return;
+    }
+
+    TaskGroup group;
+    for (size_t i = 1; i < chunks; ++i) {
+        group.Run([&body, i] {
+            body(i);
+        });
+    }
+    body(size_t(0));
+    group.Wait();
+}
+
+// Вызывает body(begin, end) для отрезков [0, count), размеченных как в ParallelConstruct
+template <typename Body>
+inline void ParallelFor(ParallelTag policy, size_t count, size_t element_size, Body body) {
+    const size_t chunks = ChunkCount(policy, count, element_size);
+    auto run = [&body, count, chunks](size_t index) {
+        body(ChunkBegin(count, chunks, index), ChunkBegin(count, chunks, index + 1));
+    };
+    RunChunks(chunks, run);
+}
+
+// Буфер с элементами, перемещёнными из сортируемого массива
+template <typename T, typename Allocator>
+class SortBuffer {
+public:
+    SortBuffer(ParallelTag policy, T* source, size_t size, const Allocator& alloc) : data_(size, alloc), size_(size) {
+        T* destination = data_.GetAddress();
+        ParallelConstruct(
+            policy, size, sizeof(T),
+            [source, destination](size_t first, size_t last) {
+                std::uninitialized_move(source + first, source + last, destination + first);
+            },
+            [destination](size_t first, size_t last) {
+                std::destroy(destination + first, destination + last);
+            });
+    }
+
+    ~SortBuffer() {
+        std::destroy_n(data_.GetAddress(), size_);
+    }
+
+    SortBuffer(const SortBuffer&) = delete;
+    SortBuffer& operator=(const SortBuffer&) = delete;
+
+    T* Data() noexcept {
+        return data_.GetAddress();
+    }
+
+private:
+    RawMemory<T, Allocator> data_;
+    size_t size_;
+};
+
+// Число элементов первого массива среди первых index элементов их слияния
+template <typename T, typename Compare>
+inline size_t MergeSplit(const T* lhs, size_t lhs_size, const T* rhs, size_t rhs_size, size_t index, Compare& comp) {
+    size_t low = index > rhs_size ? index - rhs_size : 0;
+    size_t high = std::min(index, lhs_size);
+    while (low < high) {
+        const size_t middle = low + (high - low) / 2;
+        // Равные элементы, как в std::merge, берутся сначала из первого массива
+        if (!comp(rhs[index - middle - 1], lhs[middle])) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+// Записывает в dst элементы слияния [first, middle) и [middle, last) с номерами [begin, end),
+// из которых элементы первого массива имеют номера [lhs_begin, lhs_end)
+template <typename T, typename Compare>
+inline void MergePart(T* src, T* dst, size_t first, size_t middle, size_t begin, size_t end,
+                      size_t lhs_begin, size_t lhs_end, Compare& comp) {
+    std::merge(std::make_move_iterator(src + first + lhs_begin), std::make_move_iterator(src + first + lhs_end),
+               std::make_move_iterator(src + middle + (begin - lhs_begin)),
+               std::make_move_iterator(src + middle + (end - lhs_end)),
+               dst + first + begin, comp);
+}
+
+// Беззнаковое представление ключа, сохраняющее порядок
+template <typename Key>
+inline auto RadixBits(Key key) noexcept {
+    using Bits = std::make_unsigned_t<Key>;
+    Bits bits = static_cast<Bits>(key);
+    if constexpr (std::is_signed_v<Key>) {
+        bits ^= Bits(1) << (sizeof(Bits) * 8 - 1);
+    }
+    return bits;
+}
+
+template <typename T>
+inline void MoveBack(ParallelTag policy, T* src, T* dst, size_t size) {
+    ParallelFor(policy, size, sizeof(T), [src, dst](size_t first, size_t last) {
+        std::move(src + first, src + last, dst + first);
+    });
+}
+
+}  // namespace parallel_detail
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy, typename Compare>
+inline void Sort(ParallelTag policy, Vector<T, Allocator, GrowthPolicy, StatsPolicy>& v, Compare comp) {
+    using namespace parallel_detail;
+
+    if constexpr (std::is_integral_v<T> && !std::is_same_v<T, bool>
+                  && (std::is_same_v<Compare, std::less<>> || std::is_same_v<Compare, std::less<T>>)) {
+        RadixSort(policy, v);
+        return;
+    } else {
+        const size_t size = v.Size();
+        T* data = v.Data();
+        const size_t chunks = ChunkCount(policy, size, sizeof(T));
+        if (chunks == 1) {
+            std::sort(data, data + size, comp);
+            return;
+        }
+
+        ParallelFor(policy, size, sizeof(T), [data, &comp](size_t first, size_t last) {
+            std::sort(data + first, data + last, comp);
+        });
+
+        SortBuffer<T, Allocator> buffer(policy, data, size, v.GetAllocator());
+        // Границы отсортированных серий
+        Vector<size_t> bounds(chunks + 1);
+        for (size_t i = 0; i <= chunks; ++i) {
+            bounds[i] = ChunkBegin(size, chunks, i);
+        }
+
+        // Элементы перемещены в буфер, и исходный массив служит вторым буфером слияний
+        T* src = buffer.Data();
+        T* dst = data;
+        Vector<size_t> splits;
+        for (size_t runs = chunks; runs > 1; runs = (runs + 1) / 2) {
+            TaskGroup group;
+            for (size_t run = 0; run < runs; run += 2) {
+                const size_t first = bounds[run];
+                const size_t middle = bounds[std::min(run + 1, runs)];
+                const size_t last = bounds[std::min(run + 2, runs)];
+                const size_t parts = ChunkCount(policy, last - first, sizeof(T));
+
+                // Поиск границ читает элементы соседних частей, поэтому все границы
+                // находятся до того, как части начнут перемещать элементы
+                splits.Resize(parts + 1);
+                for (size_t part = 0; part <= parts; ++part) {
+                    splits[part] = MergeSplit(src + first, middle - first, src + middle, last - middle,
+                                              ChunkBegin(last - first, parts, part), comp);
+                }
+                for (size_t part = 0; part < parts; ++part) {
+                    group.Run([=, &comp, lhs_begin = splits[part], lhs_end = splits[part + 1]] {
+                        MergePart(src, dst, first, middle, ChunkBegin(last - first, parts, part),
+                                  ChunkBegin(last - first, parts, part + 1), lhs_begin, lhs_end, comp);
+                    });
+                }
+                bounds[run / 2] = first;
+            }
+            bounds[(runs + 1) / 2] = size;
+            group.Wait();
+            std::swap(src, dst);
+        }
+
+        if (src != data) {
+            MoveBack(policy, src, data, size);
+        }
+    }
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy, typename KeyOf>
+inline void RadixSort(ParallelTag policy, Vector<T, Allocator, GrowthPolicy, StatsPolicy>& v, KeyOf key_of) {
+    using namespace parallel_detail;
+    using Key = std::decay_t<std::invoke_result_t<KeyOf&, const T&>>;
+    static_assert(std::is_integral_v<Key> && !std::is_same_v<Key, bool>, "radix sort key must be an integer");
+
+    constexpr size_t RADIX = 256;
+    const size_t size = v.Size();
+    if (size < 2) {
+        return;
+    }
+
+    T* data = v.Data();
+    const size_t chunks = ChunkCount(policy, size, sizeof(T));
+    SortBuffer<T, Allocator> buffer(policy, data, size, v.GetAllocator());
+    // offsets[chunk * RADIX + digit] - сначала число элементов отрезка с этой цифрой, затем место первого из них
+    Vector<size_t> offsets(chunks * RADIX);
+
+    T* src = buffer.Data();
+    T* dst = data;
+    for (unsigned shift = 0; shift < sizeof(Key) * 8; shift += 8) {
+        auto digit = [&key_of, shift](const T& value) {
+            return static_cast<size_t>((RadixBits(key_of(value)) >> shift) & (RADIX - 1));
+        };
+
+        auto count = [&](size_t chunk) {
+            size_t* histogram = offsets.Data() + chunk * RADIX;
+            std::fill_n(histogram, RADIX, 0);
+            for (size_t i = ChunkBegin(size, chunks, chunk); i < ChunkBegin(size, chunks, chunk + 1); ++i) {
+                ++histogram[digit(src[i])];
+            }
+        };
+        RunChunks(chunks, count);
+
+        size_t offset = 0;
+        bool single_digit = false;
+        for (size_t d = 0; d < RADIX && !single_digit; ++d) {
+            const size_t first = offset;
+            for (size_t chunk = 0; chunk < chunks; ++chunk) {
+                const size_t n = offsets[chunk * RADIX + d];
+                offsets[chunk * RADIX + d] = offset;
+                offset += n;
+            }
+            single_digit = offset - first == size;
+        }
+        if (single_digit) {
+            continue;
+        }
+
+        auto scatter = [&](size_t chunk) {
+            size_t* position = offsets.Data() + chunk * RADIX;
+            for (size_t i = ChunkBegin(size, chunks, chunk); i < ChunkBegin(size, chunks, chunk + 1); ++i) {
+                dst[position[digit(src[i])]++] = std::move(src[i]);
+            }
+        };
+        RunChunks(chunks, scatter);
+        std::swap(src, dst);
+    }
+
+    if (src != data) {
+        MoveBack(policy, src, data, size);
+    }
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy, typename UnaryOperation>
+inline void Transform(ParallelTag policy, Vector<T, Allocator, GrowthPolicy, StatsPolicy>& v, UnaryOperation op) {
+    T* data = v.Data();
+    parallel_detail::ParallelFor(policy, v.Size(), sizeof(T), [data, &op](size_t first, size_t last) {
+        std::transform(data + first, data + last, data + first, op);
+    });
+}
+
+template <typename T, typename AllocatorSrc, typename GrowthPolicySrc, typename StatsPolicySrc,
+          typename U, typename AllocatorDst, typename GrowthPolicyDst, typename StatsPolicyDst, typename UnaryOperation>
+inline void Transform(ParallelTag policy, const Vector<T, AllocatorSrc, GrowthPolicySrc, StatsPolicySrc>& src,
+                      Vector<U, AllocatorDst, GrowthPolicyDst, StatsPolicyDst>& dst, UnaryOperation op) {
+    dst.Resize(policy, src.Size());
+
+    const T* source = src.Data();
+    U* destination = dst.Data();
+    parallel_detail::ParallelFor(policy, src.Size(), sizeof(T), [source, destination, &op](size_t first, size_t last) {
+        std::transform(source + first, source + last, destination + first, op);
+    });
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy, typename Value, typename BinaryOperation>
+inline Value Reduce(ParallelTag policy, const Vector<T, Allocator, GrowthPolicy, StatsPolicy>& v, Value init,
+                    BinaryOperation op, Value identity) {
+    using namespace parallel_detail;
+
+    const size_t size = v.Size();
+    if (size == 0) {
+        return init;
+    }
+
+    const T* data = v.Data();
+    const size_t chunks = ChunkCount(policy, size, sizeof(T));
+    auto partial = std::make_unique<std::optional<Value>[]>(chunks);
+
+    auto reduce = [&](size_t chunk) {
+        const size_t first = ChunkBegin(size, chunks, chunk);
+        const size_t last = ChunkBegin(size, chunks, chunk + 1);
+        Value result = chunk == 0 ? init : identity;
+        for (size_t i = first; i < last; ++i) {
+            result = op(std::move(result), data[i]);
+        }
+        partial[chunk].emplace(std::move(result));
+    };
+    RunChunks(chunks, reduce);
+
+    Value result = std::move(*partial[0]);
+    for (size_t chunk = 1; chunk < chunks; ++chunk) {
+        result = op(std::move(result), std::move(*partial[chunk]));
+    }
+    return result;
+}
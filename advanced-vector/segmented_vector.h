@@ -0,0 +1,440 @@
+#pragma once
+
+#include "segments.h"
+#include "vector.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+// Вектор из сегментов геометрически растущего размера. При росте добавляется новый
+// сегмент, и существующие элементы никогда не перемещаются: ссылки, указатели и
+// итераторы остаются валидными до удаления самого элемента, а добавление занимает
+// O(1) без пауз на копирование всего буфера. Индекс переводится в сегмент и смещение
+// по старшему биту. Элементы не лежат в памяти подряд
+template <typename T, typename Allocator = std::allocator<T>, size_t FirstSegmentSize = 16>
+class SegmentedVector {
+    using AllocTraits = std::allocator_traits<Allocator>;
+    using Index = SegmentIndex<FirstSegmentSize>;
+    using Segment = RawMemory<T, Allocator>;
+    using SpineAllocator = typename AllocTraits::template rebind_alloc<Segment>;
+
+    template <bool IsConst>
+    class Iterator;
+
+public:
+    using value_type = T;
+    using allocator_type = Allocator;
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    SegmentedVector() = default;
+    ~SegmentedVector();
+
+    explicit SegmentedVector(const Allocator& alloc) noexcept;
+    explicit SegmentedVector(size_t size, const Allocator& alloc = Allocator());
+    SegmentedVector(std::initializer_list<T> init_list, const Allocator& alloc = Allocator());
+
+    SegmentedVector(const SegmentedVector& other);
+    SegmentedVector(SegmentedVector&& other) noexcept;
+
+    SegmentedVector& operator=(const SegmentedVector& other);
+    SegmentedVector& operator=(SegmentedVector&& other) noexcept;
+
+    const T& operator[](size_t index) const noexcept;
+    T& operator[](size_t index) noexcept;
+
+    const T& At(size_t index) const;
+    T& At(size_t index);
+
+    const T& Front() const noexcept;
+    T& Front() noexcept;
+
+    const T& Back() const noexcept;
+    T& Back() noexcept;
+
+    iterator begin() noexcept;
+    iterator end() noexcept;
+    const_iterator begin() const noexcept;
+    const_iterator end() const noexcept;
+    const_iterator cbegin() const noexcept;
+    const_iterator cend() const noexcept;
+
+    size_t Capacity() const noexcept;
+    size_t Size() const noexcept;
+    bool Empty() const noexcept;
+
+    template <typename Value>
+    void PushBack(Value&& value);
+
+    // Аргументы могут ссылаться на элементы самого вектора: они не перемещаются при росте
+    template <typename... Args>
+    T& EmplaceBack(Args&&... args);
+
+    void PopBack() noexcept;
+
+    void Reserve(size_t new_capacity);
+    void Resize(size_t new_size);
+
+    void Swap(SegmentedVector& other) noexcept;
+
+    Allocator GetAllocator() const noexcept;
+
+private:
+    Allocator alloc_;
+    Vector<Segment, SpineAllocator> segments_;
+    size_t size_ = 0;
+
+    T* Slot(size_t index) noexcept;
+    const T* Slot(size_t index) const noexcept;
+
+    // Добавляет сегменты, пока ёмкость меньше new_capacity
+    void AddSegments(size_t new_capacity);
+};
+
+// Итератор произвольного доступа; хранит вектор и индекс, поэтому остаётся валидным при росте
+template <typename T, typename Allocator, size_t FirstSegmentSize>
+template <bool IsConst>
+class SegmentedVector<T, Allocator, FirstSegmentSize>::Iterator {
+    using Owner = std::conditional_t<IsConst, const SegmentedVector, SegmentedVector>;
+
+public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = std::conditional_t<IsConst, const T*, T*>;
+    using reference = std::conditional_t<IsConst, const T&, T&>;
+
+    Iterator() = default;
+    Iterator(Owner* owner, size_t index) noexcept : owner_(owner),
+                                                    index_(index) {
+    }
+
+    template <bool OtherConst, typename = std::enable_if_t<IsConst && !OtherConst>>
+    Iterator(const Iterator<OtherConst>& other) noexcept : owner_(other.owner_),
+                                                           index_(other.index_) {
+    }
+
+    reference operator*() const noexcept {
+        return (*owner_)[index_];
+    }
+    pointer operator->() const noexcept {
+        return &(*owner_)[index_];
+    }
+    reference operator[](difference_type offset) const noexcept {
+        return (*owner_)[index_ + offset];
+    }
+
+    Iterator& operator++() noexcept {
+        ++index_;
+        return *this;
+    }
+    Iterator operator++(int) noexcept {
+        Iterator result = *this;
+        ++index_;
+        return result;
+    }
+    Iterator& operator--() noexcept {
+        --index_;
+        return *this;
+    }
+    Iterator operator--(int) noexcept {
+        Iterator result = *this;
+        --index_;
+        return result;
+    }
+
+    Iterator& operator+=(difference_type offset) noexcept {
+        index_ += offset;
+        return *this;
+    }
+    Iterator& operator-=(difference_type offset) noexcept {
+        index_ -= offset;
+        return *this;
+    }
+
+    friend Iterator operator+(Iterator it, difference_type offset) noexcept {
+        return it += offset;
+    }
+    friend Iterator operator+(difference_type offset, Iterator it) noexcept {
+        return it += offset;
+    }
+    friend Iterator operator-(Iterator it, difference_type offset) noexcept {
+        return it -= offset;
+    }
+    friend difference_type operator-(const Iterator& lhs, const Iterator& rhs) noexcept {
+        return static_cast<difference_type>(lhs.index_) - static_cast<difference_type>(rhs.index_);
+    }
+
+    friend bool operator==(const Iterator& lhs, const Iterator& rhs) noexcept {
+        return lhs.index_ == rhs.index_;
+    }
+    friend bool operator!=(const Iterator& lhs, const Iterator& rhs) noexcept {
+        return lhs.index_ != rhs.index_;
+    }
+    friend bool operator<(const Iterator& lhs, const Iterator& rhs) noexcept {
+        return lhs.index_ < rhs.index_;
+    }
+    friend bool operator>(const Iterator& lhs, const Iterator& rhs) noexcept {
+        return lhs.index_ > rhs.index_;
+    }
+    friend bool operator<=(const Iterator& lhs, const Iterator& rhs) noexcept {
+        return lhs.index_ <= rhs.index_;
+    }
+    friend bool operator>=(const Iterator& lhs, const Iterator& rhs) noexcept {
+        return lhs.index_ >= rhs.index_;
+    }
+
+private:
+    template <bool OtherConst>
+    friend class Iterator;
+
+    Owner* owner_ = nullptr;
+    size_t index_ = 0;
+};
+
+//-------------------------SEGMENTED_VECTOR---------------------
+template <typename T, typename Allocator, size_t FirstSegmentSize>
+inline SegmentedVector<T, Allocator, FirstSegmentSize>::~SegmentedVector() {
+    Resize(0);
+}
+
+template <typename T, typename Allocator, size_t FirstSegmentSize>
+inline SegmentedVector<T, Allocator, FirstSegmentSize>::SegmentedVector(const Allocator& alloc) noexcept
+    : alloc_(alloc),
+      segments_(SpineAllocator(alloc)) {
+}
+
+template <typename T, typename Allocator, size_t FirstSegmentSize>
+inline SegmentedVector<T, Allocator, FirstSegmentSize>::SegmentedVector(size_t size, const Allocator& alloc) : SegmentedVector(alloc) {
+    Resize(size);
+}
+
+template <typename T, typename Allocator, size_t FirstSegmentSize>
+inline SegmentedVector<T, Allocator, FirstSegmentSize>::SegmentedVector(std::initializer_list<T> init_list, const Allocator& alloc)
+    : SegmentedVector(alloc) {
+    Reserve(init_list.size());
+    for (const T& value : init_list) {
+        EmplaceBack(value);
+    }
+}
+
+template <typename T, typename Allocator, size_t FirstSegmentSize>
+inline SegmentedVector<T, Allocator, FirstSegmentSize>::SegmentedVector(const SegmentedVector& other)
+    : SegmentedVector(AllocTraits::select_on_container_copy_construction(other.alloc_)) {
+    Reserve(other.size_);
+    for (const T& value : other) {
+        EmplaceBack(value);
+    }
+}
+
+template <typename T, typename Allocator, size_t FirstSegmentSize>
+inline SegmentedVector<T, Allocator, FirstSegmentSize>::SegmentedVector(SegmentedVector&& other) noexcept
+    : alloc_(other.alloc_),
+      segments_(std::move(other.segments_)),
+      size_(std::exchange(other.size_, 0)) {
+}
+
+template <typename T, typename Allocator, size_t FirstSegmentSize>
+inline SegmentedVector<T, Allocator, FirstSegmentSize>& SegmentedVector<T, Allocator, FirstSegmentSize>::operator=(const SegmentedVector& other) {
+    if (this != &other) {
+        SegmentedVector copy(other);
+        Swap(copy);
+    }
+    return *this;
+}
+
+template <typename T, typename Allocator, size_t FirstSegmentSize>
+inline SegmentedVector<T, Allocator, FirstSegmentSize>& SegmentedVector<T, Allocator, FirstSegmentSize>::operator=(SegmentedVector&& other) noexcept {
+    if (this != &other) {
+        SegmentedVector moved(std::move(other));
+        Swap(moved);
+    }
+    return *this;
+}
+
+template <typename T, typename Allocator, size_t FirstSegmentSize>
+inline const T& SegmentedVector<T, Allocator, FirstSegmentSize>::operator[](size_t index) const noexcept {
+    assert(index < size_);
+    return *Slot(index);
+}
+
+template <typename T, typename Allocator, size_t FirstSegmentSize>
+inline T& SegmentedVector<T, Allocator, FirstSegmentSize>::operator[](size_t index) noexcept {
+    assert(index < size_);
+    return *Slot(index);
+}
+
+template <typename T, typename Allocator, size_t FirstSegmentSize>
+inline const T& SegmentedVector<T, Allocator, FirstSegmentSize>::At(size_t index) const {
+    if (index >= size_) {
+        throw std::out_of_range("Index out of range");
+    }
+    return *Slot(index);
+}
+
+template <typename T, typename Allocator, size_t FirstSegmentSize>
+inline T& SegmentedVector<T, Allocator, FirstSegmentSize>::At(size_t index) {
+    if (index >= size_) {
+        throw std::out_of_range("Index out of range");
+    }
+    return *Slot(index);
+}
+
+template <typename T, typename Allocator, size_t FirstSegmentSize>
+inline const T& SegmentedVector<T, Allocator, FirstSegmentSize>::Front() const noexcept {
+    assert(size_ != 0);
+    return *Slot(0);
+}
+
+template <typename T, typename Allocator, size_t FirstSegmentSize>
+inline T& SegmentedVector<T, Allocator, FirstSegmentSize>::Front() noexcept {
+    assert(size_ != 0);
+    return *Slot(0);
+}
+
+template <typename T, typename Allocator, size_t FirstSegmentSize>
+inline const T& SegmentedVector<T, Allocator, FirstSegmentSize>::Back() const noexcept {
+    assert(size_ != 0);
+    return *Slot(size_ - 1);
+}
+
+template <typename T, typename Allocator, size_t FirstSegmentSize>
+inline T& SegmentedVector<T, Allocator, FirstSegmentSize>::Back() noexcept {
+    assert(size_ != 0);
+    return *Slot(size_ - 1);
+}
+
+template <typename T, typename Allocator, size_t FirstSegmentSize>
+inline typename SegmentedVector<T, Allocator, FirstSegmentSize>::iterator SegmentedVector<T, Allocator, FirstSegmentSize>::begin() noexcept {
+    return iterator(this, 0);
+}
+
+template <typename T, typename Allocator, size_t FirstSegmentSize>
+inline typename SegmentedVector<T, Allocator, FirstSegmentSize>::iterator SegmentedVector<T, Allocator, FirstSegmentSize>::end() noexcept {
+    return iterator(this, size_);
+}
+
+template <typename T, typename Allocator, size_t FirstSegmentSize>
+inline typename SegmentedVector<T, Allocator, FirstSegmentSize>::const_iterator SegmentedVector<T, Allocator, FirstSegmentSize>::begin() const noexcept {
+    return const_iterator(this, 0);
+}
+
+template <typename T, typename Allocator, size_t FirstSegmentSize>
+inline typename SegmentedVector<T, Allocator, FirstSegmentSize>::const_iterator SegmentedVector<T, Allocator, FirstSegmentSize>::end() const noexcept {
+    return const_iterator(this, size_);
+}
+
+template <typename T, typename Allocator, size_t FirstSegmentSize>
+inline typename SegmentedVector<T, Allocator, FirstSegmentSize>::const_iterator SegmentedVector<T, Allocator, FirstSegmentSize>::cbegin() const noexcept {
+    return begin();
+}
+
+template <typename T, typename Allocator, size_t FirstSegmentSize>
+inline typename SegmentedVector<T, Allocator, FirstSegmentSize>::const_iterator SegmentedVector<T, Allocator, FirstSegmentSize>::cend() const noexcept {
+    return end();
+}
+
+template <typename T, typename Allocator, size_t FirstSegmentSize>
+inline size_t SegmentedVector<T, Allocator, FirstSegmentSize>::Capacity() const noexcept {
+    return Index::SegmentBegin(segments_.Size());
+}
+
+template <typename T, typename Allocator, size_t FirstSegmentSize>
+inline size_t SegmentedVector<T, Allocator, FirstSegmentSize>::Size() const noexcept {
+    return size_;
+}
+
+template <typename T, typename Allocator, size_t FirstSegmentSize>
+inline bool SegmentedVector<T, Allocator, FirstSegmentSize>::Empty() const noexcept {
+    return size_ == 0;
+}
+
+template <typename T, typename Allocator, size_t FirstSegmentSize>
+template <typename Value>
+inline void SegmentedVector<T, Allocator, FirstSegmentSize>::PushBack(Value&& value) {
+    EmplaceBack(std::forward<Value>(value));
+}
+
+template <typename T, typename Allocator, size_t FirstSegmentSize>
+template <typename... Args>
+inline T& SegmentedVector<T, Allocator, FirstSegmentSize>::EmplaceBack(Args&&... args) {
+    if (size_ == Capacity()) {
+        AddSegments(size_ + 1);
+    }
+
+    T* slot = new (Slot(size_)) T(std::forward<Args>(args)...);
+    ++size_;
+    return *slot;
+}
+
+template <typename T, typename Allocator, size_t FirstSegmentSize>
+inline void SegmentedVector<T, Allocator, FirstSegmentSize>::PopBack() noexcept {
+    assert(size_ != 0);
+    std::destroy_at(Slot(--size_));
+}
+
+template <typename T, typename Allocator, size_t FirstSegmentSize>
+inline void SegmentedVector<T, Allocator, FirstSegmentSize>::Reserve(size_t new_capacity) {
+    if (new_capacity > Capacity()) {
+        AddSegments(new_capacity);
+    }
+}
+
+template <typename T, typename Allocator, size_t FirstSegmentSize>
+inline void SegmentedVector<T, Allocator, FirstSegmentSize>::Resize(size_t new_size) {
+    while (size_ > new_size) {
+        PopBack();
+    }
+
+    Reserve(new_size);
+    // Элементы строятся посегментно; при исключении построенные ранее сегменты остаются в векторе
+    while (size_ < new_size) {
+        const size_t segment = Index::Segment(size_);
+        const size_t count = std::min(new_size, Index::SegmentBegin(segment + 1)) - size_;
+        std::uninitialized_value_construct_n(Slot(size_), count);
+        size_ += count;
+    }
+}
+
+template <typename T, typename Allocator, size_t FirstSegmentSize>
+inline void SegmentedVector<T, Allocator, FirstSegmentSize>::Swap(SegmentedVector& other) noexcept {
+    using std::swap;
+    if constexpr (AllocTraits::propagate_on_container_swap::value) {
+        swap(alloc_, other.alloc_);
+    } else {
+        assert(alloc_ == other.alloc_);
+    }
+    segments_.Swap(other.segments_);
+    swap(size_, other.size_);
+}
+
+template <typename T, typename Allocator, size_t FirstSegmentSize>
+inline Allocator SegmentedVector<T, Allocator, FirstSegmentSize>::GetAllocator() const noexcept {
+    return alloc_;
+}
+
+template <typename T, typename Allocator, size_t FirstSegmentSize>
+inline T* SegmentedVector<T, Allocator, FirstSegmentSize>::Slot(size_t index) noexcept {
+    const size_t segment = Index::Segment(index);
+    return segments_[segment] + Index::Offset(index, segment);
+}
+
+template <typename T, typename Allocator, size_t FirstSegmentSize>
+inline const T* SegmentedVector<T, Allocator, FirstSegmentSize>::Slot(size_t index) const noexcept {
+    const size_t segment = Index::Segment(index);
+    return segments_[segment] + Index::Offset(index, segment);
+}
+
+template <typename T, typename Allocator, size_t FirstSegmentSize>
+inline void SegmentedVector<T, Allocator, FirstSegmentSize>::AddSegments(size_t new_capacity) {
+    while (Capacity() < new_capacity) {
+        segments_.EmplaceBack(Index::SegmentSize(segments_.Size()), alloc_);
+    }
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <climits>
+#include <cstddef>
+
+// Номер старшего единичного бита, x > 0
+inline size_t Log2Floor(size_t x) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return sizeof(unsigned long long) * CHAR_BIT - 1 - static_cast<size_t>(__builtin_clzll(x));
+#else
+    size_t result = 0;
+    while (x >>= 1) {
+        ++result;
+    }
+    return result;
+#endif
+}
+
+// Разбиение индексов на сегменты геометрически растущего размера: сегмент k хранит
+// FirstSegmentSize << k элементов, и за k сегментов набирается FirstSegmentSize * (2^k - 1).
+// Номер сегмента и смещение в нём вычисляются за O(1) по старшему биту index + FirstSegmentSize
+template <size_t FirstSegmentSize>
+struct SegmentIndex {
+    static_assert(FirstSegmentSize != 0 && (FirstSegmentSize & (FirstSegmentSize - 1)) == 0,
+                  "first segment size must be a power of two");
+
+    static constexpr size_t FIRST_SHIFT = [] {
+        size_t shift = 0;
+        while ((size_t(1) << shift) != FirstSegmentSize) {
+            ++shift;
+        }
+        return shift;
+    }();
+
+    // Сегментов достаточно, чтобы адресовать любой индекс типа size_t
+    static constexpr size_t MAX_SEGMENTS = sizeof(size_t) * CHAR_BIT - FIRST_SHIFT;
+
+    static size_t Segment(size_t index) noexcept {
+        return Log2Floor(index + FirstSegmentSize) - FIRST_SHIFT;
+    }
+
+    static size_t Offset(size_t index, size_t segment) noexcept {
+        return index + FirstSegmentSize - (FirstSegmentSize << segment);
+    }
+
+    static constexpr size_t SegmentSize(size_t segment) noexcept {
+        return FirstSegmentSize << segment;
+    }
+
+    // Индекс первого элемента сегмента и суммарная ёмкость предыдущих сегментов
+    static constexpr size_t SegmentBegin(size_t segment) noexcept {
+        return (FirstSegmentSize << segment) - FirstSegmentSize;
+    }
+};
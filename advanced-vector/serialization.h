@@ -0,0 +1,263 @@
+#pragma once
+
+#include "vector.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+// Двоичный формат вектора: заголовок SerializedVectorHeader и следом элементы.
+// Тривиально копируемые элементы записываются одним блоком в порядке байт и с
+// выравниванием текущей платформы. Остальные типы записываются по одному через
+// VectorCodec<T>, который нужно специализировать для своего типа
+
+struct SerializedVectorHeader {
+    static constexpr uint32_t MAGIC = 0x43455641;  // "AVEC"
+    static constexpr uint32_t VERSION = 1;
+
+    enum Encoding : uint32_t {
+        RAW = 0,    // элементы скопированы побайтово
+        CODEC = 1,  // элементы записаны VectorCodec<T>
+    };
+
+    uint32_t magic = MAGIC;
+    uint32_t version = VERSION;
+    uint32_t encoding = RAW;
+    uint32_t element_size = 0;
+    uint64_t size = 0;
+};
+
+// Поэлементный кодек для типов, которые нельзя копировать побайтово:
+//     static void Write(std::ostream& out, const T& value);
+//     static T Read(std::istream& in);
+// Read бросает исключение, если данных недостаточно
+template <typename T, typename = void>
+struct VectorCodec;
+
+// Длина строки и её символы
+template <typename Char, typename Traits, typename Alloc>
+struct VectorCodec<std::basic_string<Char, Traits, Alloc>> {
+    static void Write(std::ostream& out, const std::basic_string<Char, Traits, Alloc>& value);
+    static std::basic_string<Char, Traits, Alloc> Read(std::istream& in);
+};
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+void Serialize(const Vector<T, Allocator, GrowthPolicy, StatsPolicy>& v, std::ostream& out);
+
+// Записывает заголовок и элементы одним вызовом writev
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+void Serialize(const Vector<T, Allocator, GrowthPolicy, StatsPolicy>& v, int fd);
+
+// Заменяет содержимое v прочитанным вектором. Для тривиально копируемых элементов память
+// выделяется один раз по размеру из заголовка, и элементы читаются прямо в неинициализированный
+// буфер вектора; элементы с кодеком добавляются по мере чтения. При ошибке бросает исключение
+// и оставляет v без изменений
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+void Deserialize(std::istream& in, Vector<T, Allocator, GrowthPolicy, StatsPolicy>& v);
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+void Deserialize(int fd, Vector<T, Allocator, GrowthPolicy, StatsPolicy>& v);
+
+namespace serialization_detail {
+
+// Размеры из заголовка и длины строк не проверены данными, поэтому по ним заранее выделяется
+// не больше READ_CHUNK_BYTES, а дальше память растёт по мере чтения
+inline constexpr size_t READ_CHUNK_BYTES = size_t{1} << 20;
+
+template <typename T>
+SerializedVectorHeader MakeHeader(size_t size) noexcept {
+    SerializedVectorHeader header;
+    header.encoding = std::is_trivially_copyable_v<T> ? SerializedVectorHeader::RAW : SerializedVectorHeader::CODEC;
+    header.element_size = static_cast<uint32_t>(sizeof(T));
+    header.size = size;
+    return header;
+}
+
+template <typename T>
+void CheckHeader(const SerializedVectorHeader& header) {
+    if (header.magic != SerializedVectorHeader::MAGIC || header.version != SerializedVectorHeader::VERSION) {
+        throw std::runtime_error("not a serialized Vector");
+    }
+    const SerializedVectorHeader expected = MakeHeader<T>(0);
+    if (header.encoding != expected.encoding || header.element_size != expected.element_size) {
+        throw std::runtime_error("serialized Vector has a different element type");
+    }
+}
+
+inline void ReadExactly(std::istream& in, void* buf, size_t bytes) {
+    if (!in.read(static_cast<char*>(buf), static_cast<std::streamsize>(bytes))) {
+        throw std::runtime_error("unexpected end of serialized Vector");
+    }
+}
+
+inline void ReadExactly(int fd, void* buf, size_t bytes) {
+    char* cursor = static_cast<char*>(buf);
+    while (bytes > 0) {
+        const ssize_t count = ::read(fd, cursor, bytes);
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        if (count < 0) {
+            throw std::system_error(errno, std::generic_category(), "read");
+        }
+        if (count == 0) {
+            throw std::runtime_error("unexpected end of serialized Vector");
+        }
+        cursor += count;
+        bytes -= static_cast<size_t>(count);
+    }
+}
+
+// Читает size элементов в конец пустого result, выделив память один раз. Тривиально
+// копируемые объекты создаются самим чтением байтов, поэтому буфер заранее не инициализируется
+template <typename Source, typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+void ReadRaw(Source& source, size_t size, Vector<T, Allocator, GrowthPolicy, StatsPolicy>& result) {
+    static_assert(std::is_trivially_copyable_v<T>);
+
+    result.ResizeAndOverwrite(size, [&source](T* data, size_t count) {
+        ReadExactly(source, static_cast<void*>(data), count * sizeof(T));
+        return count;
+    });
+}
+
+// Для обычного файла size элементов из заголовка сверяется с оставшимися байтами до
+// выделения памяти. Для каналов и сокетов размер заранее неизвестен, и ошибку обнаружит чтение
+inline void CheckAvailable(int fd, uint64_t size, size_t element_size) {
+    struct stat info {};
+    if (::fstat(fd, &info) != 0 || !S_ISREG(info.st_mode)) {
+        return;
+    }
+    const off_t position = ::lseek(fd, 0, SEEK_CUR);
+    if (position < 0 || position > info.st_size) {
+        return;
+    }
+    if (size > static_cast<uint64_t>(info.st_size - position) / element_size) {
+        throw std::runtime_error("unexpected end of serialized Vector");
+    }
+}
+
+}  // namespace serialization_detail
+
+//-------------------------VECTOR_CODEC---------------------
+template <typename Char, typename Traits, typename Alloc>
+inline void VectorCodec<std::basic_string<Char, Traits, Alloc>>::Write(std::ostream& out, const std::basic_string<Char, Traits, Alloc>& value) {
+    const uint64_t length = value.size();
+    out.write(reinterpret_cast<const char*>(&length), sizeof(length));
+    out.write(reinterpret_cast<const char*>(value.data()), static_cast<std::streamsize>(length * sizeof(Char)));
+}
+
+template <typename Char, typename Traits, typename Alloc>
+inline std::basic_string<Char, Traits, Alloc> VectorCodec<std::basic_string<Char, Traits, Alloc>>::Read(std::istream& in) {
+    uint64_t length = 0;
+    serialization_detail::ReadExactly(in, &length, sizeof(length));
+
+    std::basic_string<Char, Traits, Alloc> value;
+    constexpr size_t chunk = std::max<size_t>(serialization_detail::READ_CHUNK_BYTES / sizeof(Char), 1);
+    while (length > value.size()) {
+        const size_t read = value.size();
+        value.resize(read + static_cast<size_t>(std::min<uint64_t>(length - read, chunk)));
+        serialization_detail::ReadExactly(in, value.data() + read, (value.size() - read) * sizeof(Char));
+    }
+    return value;
+}
+
+//-------------------------SERIALIZATION---------------------
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline void Serialize(const Vector<T, Allocator, GrowthPolicy, StatsPolicy>& v, std::ostream& out) {
+    const SerializedVectorHeader header = serialization_detail::MakeHeader<T>(v.Size());
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    if constexpr (std::is_trivially_copyable_v<T>) {
+        out.write(reinterpret_cast<const char*>(v.Data()), static_cast<std::streamsize>(v.Size() * sizeof(T)));
+    } else {
+        for (const T& value : v) {
+            VectorCodec<T>::Write(out, value);
+        }
+    }
+
+    if (!out) {
+        throw std::runtime_error("failed to write serialized Vector");
+    }
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline void Serialize(const Vector<T, Allocator, GrowthPolicy, StatsPolicy>& v, int fd) {
+    static_assert(std::is_trivially_copyable_v<T>, "use the std::ostream overload for elements with a VectorCodec");
+
+    const SerializedVectorHeader header = serialization_detail::MakeHeader<T>(v.Size());
+    iovec parts[2] = {
+        {const_cast<SerializedVectorHeader*>(&header), sizeof(header)},
+        {const_cast<void*>(static_cast<const void*>(v.Data())), v.Size() * sizeof(T)},
+    };
+
+    // Неполная запись продолжается с того места, где остановилась
+    iovec* part = parts;
+    int count = v.Size() == 0 ? 1 : 2;
+    while (count > 0) {
+        const ssize_t written = ::writev(fd, part, count);
+        if (written < 0 && errno == EINTR) {
+            continue;
+        }
+        if (written < 0) {
+            throw std::system_error(errno, std::generic_category(), "writev");
+        }
+
+        size_t rest = static_cast<size_t>(written);
+        while (count > 0 && rest >= part->iov_len) {
+            rest -= part->iov_len;
+            ++part;
+            --count;
+        }
+        if (count > 0) {
+            part->iov_base = static_cast<char*>(part->iov_base) + rest;
+            part->iov_len -= rest;
+        }
+    }
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline void Deserialize(std::istream& in, Vector<T, Allocator, GrowthPolicy, StatsPolicy>& v) {
+    SerializedVectorHeader header;
+    serialization_detail::ReadExactly(in, &header, sizeof(header));
+    serialization_detail::CheckHeader<T>(header);
+
+    Vector<T, Allocator, GrowthPolicy, StatsPolicy> result(v.GetAllocator());
+    if constexpr (std::is_trivially_copyable_v<T>) {
+        serialization_detail::ReadRaw(in, static_cast<size_t>(header.size), result);
+    } else {
+        constexpr size_t chunk = std::max<size_t>(serialization_detail::READ_CHUNK_BYTES / sizeof(T), 1);
+        result.Reserve(static_cast<size_t>(std::min<uint64_t>(header.size, chunk)));
+        for (uint64_t i = 0; i < header.size; ++i) {
+            result.EmplaceBack(VectorCodec<T>::Read(in));
+        }
+    }
+
+    v.Swap(result);
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline void Deserialize(int fd, Vector<T, Allocator, GrowthPolicy, StatsPolicy>& v) {
+    static_assert(std::is_trivially_copyable_v<T>, "use the std::istream overload for elements with a VectorCodec");
+
+    SerializedVectorHeader header;
+    serialization_detail::ReadExactly(fd, &header, sizeof(header));
+    serialization_detail::CheckHeader<T>(header);
+
+    serialization_detail::CheckAvailable(fd, header.size, sizeof(T));
+
+    Vector<T, Allocator, GrowthPolicy, StatsPolicy> result(v.GetAllocator());
+    serialization_detail::ReadRaw(fd, static_cast<size_t>(header.size), result);
+
+    v.Swap(result);
+}
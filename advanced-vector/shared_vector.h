@@ -0,0 +1,452 @@
+#pragma once
+
+#include "vector.h"
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+// Вектор с копированием при записи. Копии SharedVector и снимки FrozenVector разделяют
+// один буфер с атомарным счётчиком ссылок, поэтому копирование стоит O(1), а буфер
+// копируется при первом изменении разделяемого вектора. Разные объекты, разделяющие
+// буфер, можно читать и изменять из разных потоков без синхронизации
+
+template <typename T, typename Allocator = std::allocator<T>>
+class FrozenVector;
+
+namespace shared_detail {
+
+template <typename T, typename Allocator>
+struct SharedBlock {
+    explicit SharedBlock(Vector<T, Allocator>&& data) noexcept : data(std::move(data)) {
+    }
+    explicit SharedBlock(const Vector<T, Allocator>& data) : data(data) {
+    }
+
+    std::atomic<size_t> refs{1};
+    Vector<T, Allocator> data;
+};
+
+// Владеющий указатель на разделяемый буфер. Пустой указатель соответствует пустому вектору
+template <typename T, typename Allocator>
+class SharedHandle {
+    using Block = SharedBlock<T, Allocator>;
+    using BlockAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Block>;
+    using BlockTraits = std::allocator_traits<BlockAllocator>;
+
+public:
+    SharedHandle() noexcept = default;
+    explicit SharedHandle(Vector<T, Allocator>&& data);
+    ~SharedHandle();
+
+    SharedHandle(const SharedHandle& other) noexcept;
+    SharedHandle(SharedHandle&& other) noexcept;
+    SharedHandle& operator=(const SharedHandle& rhs) noexcept;
+    SharedHandle& operator=(SharedHandle&& rhs) noexcept;
+
+    // nullptr для пустого вектора
+    const Vector<T, Allocator>* Get() const noexcept;
+    size_t UseCount() const noexcept;
+
+    // Делает буфер единоличным, копируя его, если он разделяется
+    Vector<T, Allocator>& Detach();
+    // Отказывается от буфера
+    void Reset() noexcept;
+
+    void Swap(SharedHandle& other) noexcept;
+
+private:
+    Block* block_ = nullptr;
+
+    template <typename Data>
+    static Block* Allocate(Data&& data);
+    static void Release(Block* block) noexcept;
+};
+
+}  // namespace shared_detail
+
+template <typename T, typename Allocator = std::allocator<T>>
+class SharedVector {
+public:
+    using value_type = T;
+    using allocator_type = Allocator;
+    using const_iterator = const T*;
+
+    SharedVector() noexcept = default;
+    // Забирает буфер data без копирования элементов
+    explicit SharedVector(Vector<T, Allocator>&& data);
+    SharedVector(std::initializer_list<T> init_list);
+    // Разделяет буфер снимка
+    explicit SharedVector(const FrozenVector<T, Allocator>& frozen) noexcept;
+
+    SharedVector(const SharedVector&) noexcept = default;
+    SharedVector(SharedVector&&) noexcept = default;
+    SharedVector& operator=(const SharedVector&) noexcept = default;
+    SharedVector& operator=(SharedVector&&) noexcept = default;
+
+    size_t Size() const noexcept;
+    bool Empty() const noexcept;
+    size_t Capacity() const noexcept;
+
+    // Доступ на чтение не копирует буфер
+    const T& operator[](size_t index) const noexcept;
+    const T& At(size_t index) const;
+    const T* Data() const noexcept;
+
+    const_iterator begin() const noexcept;
+    const_iterator end() const noexcept;
+    const_iterator cbegin() const noexcept;
+    const_iterator cend() const noexcept;
+
+    // Единоличный доступ к вектору для произвольных изменений. Ссылки, полученные через него,
+    // нельзя использовать для изменения после копирования SharedVector: копия разделит буфер
+    Vector<T, Allocator>& Mutable();
+
+    template <typename... Args>
+    T& EmplaceBack(Args&&... args);
+    template <typename Value>
+    void PushBack(Value&& value);
+    void PopBack();
+    void Resize(size_t new_size);
+    void Reserve(size_t new_capacity);
+    // Разделяемый буфер не очищается, а только освобождается этим вектором
+    void Clear() noexcept;
+
+    // Число объектов, разделяющих буфер; 0 для пустого вектора без буфера
+    size_t UseCount() const noexcept;
+    bool IsShared() const noexcept;
+
+    // Неизменяемый снимок текущего содержимого за O(1)
+    FrozenVector<T, Allocator> Freeze() const noexcept;
+
+    void Swap(SharedVector& other) noexcept;
+
+private:
+    shared_detail::SharedHandle<T, Allocator> handle_;
+};
+
+// Неизменяемый вектор, который разделяет буфер со своими копиями и с SharedVector
+template <typename T, typename Allocator>
+class FrozenVector {
+public:
+    using value_type = T;
+    using allocator_type = Allocator;
+    using const_iterator = const T*;
+
+    FrozenVector() noexcept = default;
+    explicit FrozenVector(Vector<T, Allocator>&& data);
+
+    size_t Size() const noexcept;
+    bool Empty() const noexcept;
+
+    const T& operator[](size_t index) const noexcept;
+    const T& At(size_t index) const;
+    const T* Data() const noexcept;
+
+    const_iterator begin() const noexcept;
+    const_iterator end() const noexcept;
+
+    size_t UseCount() const noexcept;
+
+private:
+    friend class SharedVector<T, Allocator>;
+
+    explicit FrozenVector(const shared_detail::SharedHandle<T, Allocator>& handle) noexcept;
+
+    shared_detail::SharedHandle<T, Allocator> handle_;
+};
+
+//-------------------------SHARED_HANDLE---------------------
+namespace shared_detail {
+
+template <typename T, typename Allocator>
+inline SharedHandle<T, Allocator>::SharedHandle(Vector<T, Allocator>&& data) : block_(Allocate(std::move(data))) {
+}
+
+template <typename T, typename Allocator>
+inline SharedHandle<T, Allocator>::~SharedHandle() {
+    Release(block_);
+}
+
+template <typename T, typename Allocator>
+inline SharedHandle<T, Allocator>::SharedHandle(const SharedHandle& other) noexcept : block_(other.block_) {
+    if (block_ != nullptr) {
+        block_->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+template <typename T, typename Allocator>
+inline SharedHandle<T, Allocator>::SharedHandle(SharedHandle&& other) noexcept : block_(std::exchange(other.block_, nullptr)) {
+}
+
+template <typename T, typename Allocator>
+inline SharedHandle<T, Allocator>& SharedHandle<T, Allocator>::operator=(const SharedHandle& rhs) noexcept {
+    if (this != &rhs) {
+        SharedHandle copy(rhs);
+        Swap(copy);
+    }
+    return *this;
+}
+
+template <typename T, typename Allocator>
+inline SharedHandle<T, Allocator>& SharedHandle<T, Allocator>::operator=(SharedHandle&& rhs) noexcept {
+    if (this != &rhs) {
+        Release(std::exchange(block_, std::exchange(rhs.block_, nullptr)));
+    }
+    return *this;
+}
+
+template <typename T, typename Allocator>
+inline const Vector<T, Allocator>* SharedHandle<T, Allocator>::Get() const noexcept {
+    return block_ != nullptr ? &block_->data : nullptr;
+}
+
+template <typename T, typename Allocator>
+inline size_t SharedHandle<T, Allocator>::UseCount() const noexcept {
+    return block_ != nullptr ? block_->refs.load(std::memory_order_acquire) : 0;
+}
+
+template <typename T, typename Allocator>
+inline Vector<T, Allocator>& SharedHandle<T, Allocator>::Detach() {
+    if (block_ == nullptr) {
+        block_ = Allocate(Vector<T, Allocator>());
+    } else if (block_->refs.load(std::memory_order_acquire) != 1) {
+        // Пока копия не готова, буфер остаётся разделяемым, и при исключении ничего не меняется
+        Block* copy = Allocate(block_->data);
+        Release(std::exchange(block_, copy));
+    }
+    return block_->data;
+}
+
+template <typename T, typename Allocator>
+inline void SharedHandle<T, Allocator>::Reset() noexcept {
+    Release(std::exchange(block_, nullptr));
+}
+
+template <typename T, typename Allocator>
+inline void SharedHandle<T, Allocator>::Swap(SharedHandle& other) noexcept {
+    std::swap(block_, other.block_);
+}
+
+template <typename T, typename Allocator>
+template <typename Data>
+inline typename SharedHandle<T, Allocator>::Block* SharedHandle<T, Allocator>::Allocate(Data&& data) {
+    BlockAllocator alloc(data.GetAllocator());
+    Block* block = BlockTraits::allocate(alloc, 1);
+    try {
+        BlockTraits::construct(alloc, block, std::forward<Data>(data));
+    } catch (...) {
+        BlockTraits::deallocate(alloc, block, 1);
+        throw;
+    }
+    return block;
+}
+
+template <typename T, typename Allocator>
+inline void SharedHandle<T, Allocator>::Release(Block* block) noexcept {
+    // Уменьшение с acq_rel упорядочивает чтения других владельцев перед уничтожением буфера
+    if (block == nullptr || block->refs.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+        return;
+    }
+
+    BlockAllocator alloc(block->data.GetAllocator());
+    BlockTraits::destroy(alloc, block);
+    BlockTraits::deallocate(alloc, block, 1);
+}
+
+}  // namespace shared_detail
+
+//-------------------------SHARED_VECTOR---------------------
+template <typename T, typename Allocator>
+inline SharedVector<T, Allocator>::SharedVector(Vector<T, Allocator>&& data) : handle_(std::move(data)) {
+}
+
+template <typename T, typename Allocator>
+inline SharedVector<T, Allocator>::SharedVector(std::initializer_list<T> init_list)
+    : handle_(Vector<T, Allocator>(init_list)) {
+}
+
+template <typename T, typename Allocator>
+inline SharedVector<T, Allocator>::SharedVector(const FrozenVector<T, Allocator>& frozen) noexcept : handle_(frozen.handle_) {
+}
+
+template <typename T, typename Allocator>
+inline size_t SharedVector<T, Allocator>::Size() const noexcept {
+    const auto* data = handle_.Get();
+    return data != nullptr ? data->Size() : 0;
+}
+
+template <typename T, typename Allocator>
+inline bool SharedVector<T, Allocator>::Empty() const noexcept {
+    return Size() == 0;
+}
+
+template <typename T, typename Allocator>
+inline size_t SharedVector<T, Allocator>::Capacity() const noexcept {
+    const auto* data = handle_.Get();
+    return data != nullptr ? data->Capacity() : 0;
+}
+
+template <typename T, typename Allocator>
+inline const T& SharedVector<T, Allocator>::operator[](size_t index) const noexcept {
+    assert(index < Size());
+    return Data()[index];
+}
+
+template <typename T, typename Allocator>
+inline const T& SharedVector<T, Allocator>::At(size_t index) const {
+    if (index >= Size()) {
+        throw std::out_of_range("Index out of range");
+    }
+    return Data()[index];
+}
+
+template <typename T, typename Allocator>
+inline const T* SharedVector<T, Allocator>::Data() const noexcept {
+    const auto* data = handle_.Get();
+    return data != nullptr ? data->Data() : nullptr;
+}
+
+template <typename T, typename Allocator>
+inline typename SharedVector<T, Allocator>::const_iterator SharedVector<T, Allocator>::begin() const noexcept {
+    return Data();
+}
+
+template <typename T, typename Allocator>
+inline typename SharedVector<T, Allocator>::const_iterator SharedVector<T, Allocator>::end() const noexcept {
+    return Data() + Size();
+}
+
+template <typename T, typename Allocator>
+inline typename SharedVector<T, Allocator>::const_iterator SharedVector<T, Allocator>::cbegin() const noexcept {
+    return begin();
+}
+
+template <typename T, typename Allocator>
+inline typename SharedVector<T, Allocator>::const_iterator SharedVector<T, Allocator>::cend() const noexcept {
+    return end();
+}
+
+template <typename T, typename Allocator>
+inline Vector<T, Allocator>& SharedVector<T, Allocator>::Mutable() {
+    return handle_.Detach();
+}
+
+template <typename T, typename Allocator>
+template <typename... Args>
+inline T& SharedVector<T, Allocator>::EmplaceBack(Args&&... args) {
+    return Mutable().EmplaceBack(std::forward<Args>(args)...);
+}
+
+template <typename T, typename Allocator>
+template <typename Value>
+inline void SharedVector<T, Allocator>::PushBack(Value&& value) {
+    Mutable().PushBack(std::forward<Value>(value));
+}
+
+template <typename T, typename Allocator>
+inline void SharedVector<T, Allocator>::PopBack() {
+    assert(!Empty());
+    Mutable().PopBack();
+}
+
+template <typename T, typename Allocator>
+inline void SharedVector<T, Allocator>::Resize(size_t new_size) {
+    Mutable().Resize(new_size);
+}
+
+template <typename T, typename Allocator>
+inline void SharedVector<T, Allocator>::Reserve(size_t new_capacity) {
+    if (new_capacity > Capacity()) {
+        Mutable().Reserve(new_capacity);
+    }
+}
+
+template <typename T, typename Allocator>
+inline void SharedVector<T, Allocator>::Clear() noexcept {
+    if (IsShared()) {
+        handle_.Reset();
+    } else if (handle_.Get() != nullptr) {
+        handle_.Detach().Clear();
+    }
+}
+
+template <typename T, typename Allocator>
+inline size_t SharedVector<T, Allocator>::UseCount() const noexcept {
+    return handle_.UseCount();
+}
+
+template <typename T, typename Allocator>
+inline bool SharedVector<T, Allocator>::IsShared() const noexcept {
+    return UseCount() > 1;
+}
+
+template <typename T, typename Allocator>
+inline FrozenVector<T, Allocator> SharedVector<T, Allocator>::Freeze() const noexcept {
+    return FrozenVector<T, Allocator>(handle_);
+}
+
+template <typename T, typename Allocator>
+inline void SharedVector<T, Allocator>::Swap(SharedVector& other) noexcept {
+    handle_.Swap(other.handle_);
+}
+
+//-------------------------FROZEN_VECTOR---------------------
+template <typename T, typename Allocator>
+inline FrozenVector<T, Allocator>::FrozenVector(Vector<T, Allocator>&& data) : handle_(std::move(data)) {
+}
+
+template <typename T, typename Allocator>
+inline FrozenVector<T, Allocator>::FrozenVector(const shared_detail::SharedHandle<T, Allocator>& handle) noexcept
+    : handle_(handle) {
+}
+
+template <typename T, typename Allocator>
+inline size_t FrozenVector<T, Allocator>::Size() const noexcept {
+    const auto* data = handle_.Get();
+    return data != nullptr ? data->Size() : 0;
+}
+
+template <typename T, typename Allocator>
+inline bool FrozenVector<T, Allocator>::Empty() const noexcept {
+    return Size() == 0;
+}
+
+template <typename T, typename Allocator>
+inline const T& FrozenVector<T, Allocator>::operator[](size_t index) const noexcept {
+    assert(index < Size());
+    return Data()[index];
+}
+
+template <typename T, typename Allocator>
+inline const T& FrozenVector<T, Allocator>::At(size_t index) const {
+    if (index >= Size()) {
+        throw std::out_of_range("Index out of range");
+    }
+    return Data()[index];
+}
+
+template <typename T, typename Allocator>
+inline const T* FrozenVector<T, Allocator>::Data() const noexcept {
+    const auto* data = handle_.Get();
+    return data != nullptr ? data->Data() : nullptr;
+}
+
+template <typename T, typename Allocator>
+inline typename FrozenVector<T, Allocator>::const_iterator FrozenVector<T, Allocator>::begin() const noexcept {
+    return Data();
+}
+
+template <typename T, typename Allocator>
+inline typename FrozenVector<T, Allocator>::const_iterator FrozenVector<T, Allocator>::end() const noexcept {
+    return Data() + Size();
+}
+
+template <typename T, typename Allocator>
+inline size_t FrozenVector<T, Allocator>::UseCount() const noexcept {
+    return handle_.UseCount();
+}
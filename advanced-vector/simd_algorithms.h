@@ -0,0 +1,588 @@
+#pragma once
+
+#include "vector.h"
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+// Векторизованные алгоритмы над непрерывными массивами арифметических типов.
+// Каждое ядро написано один раз на векторных расширениях GCC/Clang и собирается
+// под несколько наборов инструкций через атрибут target; нужный вариант выбирается
+// при первом вызове по возможностям процессора. В других компиляторах используются
+// скалярные циклы.
+// Сумма и скалярное произведение чисел с плавающей точкой накапливаются в нескольких
+// частичных суммах, поэтому результат может отличаться от последовательного сложения
+// в последних битах. Min и Max не определены для массивов с NaN
+
+enum class SimdLevel {
+    SCALAR,
+    SSE2,     // 16-байтные регистры: SSE2 на x86-64, NEON на ARM
+    AVX2,
+    AVX512,   // AVX-512F и AVX-512BW
+};
+
+enum class SimdCompare {
+    EQUAL,
+    NOT_EQUAL,
+    LESS,
+    LESS_EQUAL,
+    GREATER,
+    GREATER_EQUAL,
+};
+
+// Лучший доступный набор инструкций с учётом ограничения SetMaxSimdLevel
+SimdLevel GetSimdLevel() noexcept;
+// Ограничивает используемый набор инструкций, например для сравнения вариантов ядер. Возвращает прежнее ограничение
+SimdLevel SetMaxSimdLevel(SimdLevel level) noexcept;
+
+template <typename T>
+T SimdSum(const T* data, size_t size) noexcept;
+template <typename T>
+T SimdDot(const T* lhs, const T* rhs, size_t size) noexcept;
+// size > 0
+template <typename T>
+T SimdMin(const T* data, size_t size) noexcept;
+template <typename T>
+T SimdMax(const T* data, size_t size) noexcept;
+
+// Число элементов x, для которых x <cmp> value
+template <typename T>
+size_t SimdCount(const T* data, size_t size, SimdCompare cmp, T value) noexcept;
+// Индекс первого элемента x, для которого x <cmp> value, или size
+template <typename T>
+size_t SimdFind(const T* data, size_t size, SimdCompare cmp, T value) noexcept;
+// Сдвигает к началу элементы, не удовлетворяющие условию, сохраняя их порядок. Возвращает их число
+template <typename T>
+size_t SimdRemoveIf(T* data, size_t size, SimdCompare cmp, T value) noexcept;
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+T SimdSum(const Vector<T, Allocator, GrowthPolicy, StatsPolicy>& v) noexcept;
+
+template <typename T, typename AllocatorL, typename GrowthPolicyL, typename StatsPolicyL,
+          typename AllocatorR, typename GrowthPolicyR, typename StatsPolicyR>
+T SimdDot(const Vector<T, AllocatorL, GrowthPolicyL, StatsPolicyL>& lhs,
+          const Vector<T, AllocatorR, GrowthPolicyR, StatsPolicyR>& rhs) noexcept;
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+T SimdMin(const Vector<T, Allocator, GrowthPolicy, StatsPolicy>& v) noexcept;
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+T SimdMax(const Vector<T, Allocator, GrowthPolicy, StatsPolicy>& v) noexcept;
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+size_t SimdCount(const Vector<T, Allocator, GrowthPolicy, StatsPolicy>& v, SimdCompare cmp, T value) noexcept;
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+size_t SimdFind(const Vector<T, Allocator, GrowthPolicy, StatsPolicy>& v, SimdCompare cmp, T value) noexcept;
+
+// Векторизованный аналог EraseIf для условия x <cmp> value. Возвращает число удалённых элементов
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+size_t SimdEraseIf(Vector<T, Allocator, GrowthPolicy, StatsPolicy>& v, SimdCompare cmp, T value);
+
+//-------------------------SIMD_KERNELS---------------------
+#if defined(__GNUC__) || defined(__clang__)
+#define SIMD_ALWAYS_INLINE __attribute__((always_inline)) inline
+#define SIMD_VECTOR_EXTENSIONS 1
+#else
+#define SIMD_ALWAYS_INLINE inline
+#define SIMD_VECTOR_EXTENSIONS 0
+#endif
+
+namespace simd_detail {
+
+template <typename T>
+using EnableIfArithmetic = std::enable_if_t<std::is_arithmetic_v<T> && !std::is_same_v<T, bool>>;
+
+#if SIMD_VECTOR_EXTENSIONS
+// Регистр из Width байт с элементами T
+template <typename T, size_t Width>
+struct Register {
+    typedef T type __attribute__((vector_size(Width)));
+};
+
+template <typename T, size_t Width>
+using RegisterType = typename Register<T, Width>::type;
+
+// Регистры передаются через аргументы: функция, возвращающая широкий регистр, меняла бы ABI вне атрибута target
+template <typename V, typename T>
+SIMD_ALWAYS_INLINE void Load(const T* data, V& result) noexcept {
+    std::memcpy(&result, data, sizeof(V));
+}
+
+template <typename V, typename T>
+SIMD_ALWAYS_INLINE void Store(T* data, const V& value) noexcept {
+    std::memcpy(data, &value, sizeof(V));
+}
+
+// Маска сравнения содержит во всех битах дорожки 0 или 1
+template <typename M>
+SIMD_ALWAYS_INLINE bool AnyLane(const M& mask) noexcept {
+    uint64_t words[sizeof(M) / sizeof(uint64_t)];
+    std::memcpy(words, &mask, sizeof(M));
+    uint64_t result = 0;
+    for (uint64_t word : words) {
+        result |= word;
+    }
+    return result != 0;
+}
+
+template <typename M>
+SIMD_ALWAYS_INLINE bool AllLanes(const M& mask) noexcept {
+    uint64_t words[sizeof(M) / sizeof(uint64_t)];
+    std::memcpy(words, &mask, sizeof(M));
+    uint64_t result = ~uint64_t(0);
+    for (uint64_t word : words) {
+        result &= word;
+    }
+    return result == ~uint64_t(0);
+}
+#endif
+
+template <SimdCompare Compare, typename T>
+SIMD_ALWAYS_INLINE bool Matches(T lhs, T rhs) noexcept {
+    if constexpr (Compare == SimdCompare::EQUAL) {
+        return lhs == rhs;
+    } else if constexpr (Compare == SimdCompare::NOT_EQUAL) {
+        return lhs != rhs;
+    } else if constexpr (Compare == SimdCompare::LESS) {
+        return lhs < rhs;
+    } else if constexpr (Compare == SimdCompare::LESS_EQUAL) {
+        return lhs <= rhs;
+    } else if constexpr (Compare == SimdCompare::GREATER) {
+        return lhs > rhs;
+    } else {
+        return lhs >= rhs;
+    }
+}
+
+#if SIMD_VECTOR_EXTENSIONS
+template <SimdCompare Compare, typename V, typename M>
+SIMD_ALWAYS_INLINE void MatchLanes(const V& lhs, const V& rhs, M& mask) noexcept {
+    if constexpr (Compare == SimdCompare::EQUAL) {
+        mask = lhs == rhs;
+    } else if constexpr (Compare == SimdCompare::NOT_EQUAL) {
+        mask = lhs != rhs;
+    } else if constexpr (Compare == SimdCompare::LESS) {
+        mask = lhs < rhs;
+    } else if constexpr (Compare == SimdCompare::LESS_EQUAL) {
+        mask = lhs <= rhs;
+    } else if constexpr (Compare == SimdCompare::GREATER) {
+        mask = lhs > rhs;
+    } else {
+        mask = lhs >= rhs;
+    }
+}
+
+template <typename V>
+using MaskType = decltype(V{} == V{});
+#endif
+
+// Целые складываются и умножаются без знака: при переполнении результат тот же по модулю,
+// но без неопределённого поведения. Scalar не уже unsigned, чтобы не было продвижения в int
+template <typename T, bool = std::is_integral_v<T>>
+struct WrappingArithmetic {
+    using Lane = T;
+    using Scalar = T;
+};
+
+template <typename T>
+struct WrappingArithmetic<T, true> {
+    using Lane = std::make_unsigned_t<T>;
+    using Scalar = std::common_type_t<Lane, unsigned>;
+};
+
+template <SimdCompare Compare>
+using CompareTag = std::integral_constant<SimdCompare, Compare>;
+
+// Ядра параметризованы шириной регистра Width в байтах; Width == 0 означает скалярный цикл.
+// Векторная часть обрабатывает целые регистры, остаток проходит скалярный хвост
+template <size_t Width>
+struct SumKernel {
+    template <typename T>
+    SIMD_ALWAYS_INLINE static T Run(const T* data, size_t size) noexcept {
+        using Scalar = typename WrappingArithmetic<T>::Scalar;
+        Scalar result = 0;
+        size_t i = 0;
+#if SIMD_VECTOR_EXTENSIONS
+        if constexpr (Width != 0) {
+            using V = RegisterType<typename WrappingArithmetic<T>::Lane, Width>;
+            constexpr size_t LANES = Width / sizeof(T);
+            // Несколько независимых сумм скрывают задержку сложения
+            V acc[4] = {};
+            for (; i + 4 * LANES <= size; i += 4 * LANES) {
+                for (size_t k = 0; k < 4; ++k) {
+                    V x;
+                    Load(data + i + k * LANES, x);
+                    acc[k] += x;
+                }
+            }
+            const V total = (acc[0] + acc[1]) + (acc[2] + acc[3]);
+            for (size_t lane = 0; lane < LANES; ++lane) {
+                result += total[lane];
+            }
+        }
+#endif
+        for (; i < size; ++i) {
+            result += static_cast<Scalar>(data[i]);
+        }
+        return static_cast<T>(result);
+    }
+};
+
+template <size_t Width>
+struct DotKernel {
+    template <typename T>
+    SIMD_ALWAYS_INLINE static T Run(const T* lhs, const T* rhs, size_t size) noexcept {
+        using Scalar = typename WrappingArithmetic<T>::Scalar;
+        Scalar result = 0;
+        size_t i = 0;
+#if SIMD_VECTOR_EXTENSIONS
+        if constexpr (Width != 0) {
+            using V = RegisterType<typename WrappingArithmetic<T>::Lane, Width>;
+            constexpr size_t LANES = Width / sizeof(T);
+            V acc[4] = {};
+            for (; i + 4 * LANES <= size; i += 4 * LANES) {
+                for (size_t k = 0; k < 4; ++k) {
+                    V x;
+                    V y;
+                    Load(lhs + i + k * LANES, x);
+                    Load(rhs + i + k * LANES, y);
+                    acc[k] += x * y;
+                }
+            }
+            const V total = (acc[0] + acc[1]) + (acc[2] + acc[3]);
+            for (size_t lane = 0; lane < LANES; ++lane) {
+                result += total[lane];
+            }
+        }
+#endif
+        for (; i < size; ++i) {
+            result += static_cast<Scalar>(lhs[i]) * static_cast<Scalar>(rhs[i]);
+        }
+        return static_cast<T>(result);
+    }
+};
+
+// IsMax выбирает между поиском максимума и минимума
+template <size_t Width>
+struct MinMaxKernel {
+    template <typename T, bool IsMax>
+    SIMD_ALWAYS_INLINE static T Run(const T* data, size_t size, std::integral_constant<bool, IsMax>) noexcept {
+        constexpr SimdCompare BETTER = IsMax ? SimdCompare::GREATER : SimdCompare::LESS;
+        T result = data[0];
+        size_t i = 0;
+#if SIMD_VECTOR_EXTENSIONS
+        if constexpr (Width != 0) {
+            using V = RegisterType<T, Width>;
+            constexpr size_t LANES = Width / sizeof(T);
+            if (size >= LANES) {
+                V best;
+                V x;
+                MaskType<V> better;
+                Load(data, best);
+                for (i = LANES; i + LANES <= size; i += LANES) {
+                    Load(data + i, x);
+                    MatchLanes<BETTER>(x, best, better);
+                    best = better ? x : best;
+                }
+                for (size_t lane = 0; lane < LANES; ++lane) {
+                    result = Matches<BETTER>(best[lane], result) ? best[lane] : result;
+                }
+            }
+        }
+#endif
+        for (; i < size; ++i) {
+            result = Matches<BETTER>(data[i], result) ? data[i] : result;
+        }
+        return result;
+    }
+};
+
+template <size_t Width>
+struct CountKernel {
+    template <typename T, SimdCompare Compare>
+    SIMD_ALWAYS_INLINE static size_t Run(const T* data, size_t size, T value, CompareTag<Compare>) noexcept {
+        size_t result = 0;
+        size_t i = 0;
+#if SIMD_VECTOR_EXTENSIONS
+        if constexpr (Width != 0) {
+            using V = RegisterType<T, Width>;
+            constexpr size_t LANES = Width / sizeof(T);
+            // Счётчик в дорожке маски сбрасывается в result раньше, чем переполнится
+            constexpr size_t FLUSH = sizeof(T) >= sizeof(int64_t)
+                                   ? std::numeric_limits<size_t>::max()
+                                   : (size_t(1) << (sizeof(T) * 8 - 1)) - 1;
+            const V pattern = V{} + value;
+
+            while (i + LANES <= size) {
+                MaskType<V> acc = {};
+                MaskType<V> mask;
+                V x;
+                for (size_t step = 0; step < FLUSH && i + LANES <= size; ++step, i += LANES) {
+                    Load(data + i, x);
+                    MatchLanes<Compare>(x, pattern, mask);
+                    acc -= mask;
+                }
+                for (size_t lane = 0; lane < LANES; ++lane) {
+                    result += static_cast<size_t>(acc[lane]);
+                }
+            }
+        }
+#endif
+        for (; i < size; ++i) {
+            result += Matches<Compare>(data[i], value) ? 1 : 0;
+        }
+        return result;
+    }
+};
+
+template <size_t Width>
+struct FindKernel {
+    template <typename T, SimdCompare Compare>
+    SIMD_ALWAYS_INLINE static size_t Run(const T* data, size_t size, T value, CompareTag<Compare>) noexcept {
+        size_t i = 0;
+#if SIMD_VECTOR_EXTENSIONS
+        if constexpr (Width != 0) {
+            using V = RegisterType<T, Width>;
+            constexpr size_t LANES = Width / sizeof(T);
+            const V pattern = V{} + value;
+            MaskType<V> mask;
+            V x;
+            for (; i + LANES <= size; i += LANES) {
+                Load(data + i, x);
+                MatchLanes<Compare>(x, pattern, mask);
+                if (AnyLane(mask)) {
+                    break;
+                }
+            }
+        }
+#endif
+        for (; i < size; ++i) {
+            if (Matches<Compare>(data[i], value)) {
+                return i;
+            }
+        }
+        return size;
+    }
+};
+
+template <size_t Width>
+struct RemoveIfKernel {
+    template <typename T, SimdCompare Compare>
+    SIMD_ALWAYS_INLINE static size_t Run(T* data, size_t size, T value, CompareTag<Compare>) noexcept {
+        size_t kept = 0;
+        size_t i = 0;
+#if SIMD_VECTOR_EXTENSIONS
+        if constexpr (Width != 0) {
+            using V = RegisterType<T, Width>;
+            constexpr size_t LANES = Width / sizeof(T);
+            const V pattern = V{} + value;
+            MaskType<V> removed;
+            V x;
+            for (; i + LANES <= size; i += LANES) {
+                Load(data + i, x);
+                MatchLanes<Compare>(x, pattern, removed);
+
+                // Регистр целиком прочитан до записи, поэтому перекрытие с kept <= i безопасно
+                if (!AnyLane(removed)) {
+                    Store(data + kept, x);
+                    kept += LANES;
+                } else if (!AllLanes(removed)) {
+                    for (size_t lane = 0; lane < LANES; ++lane) {
+                        data[kept] = x[lane];
+                        kept += removed[lane] == 0 ? 1 : 0;
+                    }
+                }
+            }
+        }
+#endif
+        // Запись без ветвлений: элемент пишется всегда, а позиция сдвигается только для оставленных
+        for (; i < size; ++i) {
+            const T x = data[i];
+            data[kept] = x;
+            kept += Matches<Compare>(x, value) ? 0 : 1;
+        }
+        return kept;
+    }
+};
+
+#if SIMD_VECTOR_EXTENSIONS && (defined(__x86_64__) || defined(__i386__))
+#define SIMD_X86_DISPATCH 1
+
+template <template <size_t> class Kernel, typename... Args>
+__attribute__((target("avx512f,avx512bw"))) auto RunAvx512(Args... args) noexcept {
+    return Kernel<64>::Run(args...);
+}
+
+template <template <size_t> class Kernel, typename... Args>
+__attribute__((target("avx2"))) auto RunAvx2(Args... args) noexcept {
+    return Kernel<32>::Run(args...);
+}
+
+inline SimdLevel DetectSimdLevel() noexcept {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")) {
+        return SimdLevel::AVX512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return SimdLevel::AVX2;
+    }
+    return __builtin_cpu_supports("sse2") ? SimdLevel::SSE2 : SimdLevel::SCALAR;
+}
+#else
+#define SIMD_X86_DISPATCH 0
+
+inline SimdLevel DetectSimdLevel() noexcept {
+#if SIMD_VECTOR_EXTENSIONS
+    // Регистры по 16 байт компилятор отображает на NEON или на скалярные операции
+    return SimdLevel::SSE2;
+#else
+    return SimdLevel::SCALAR;
+#endif
+}
+#endif
+
+inline std::atomic<SimdLevel> max_simd_level{SimdLevel::AVX512};
+
+template <template <size_t> class Kernel, typename... Args>
+inline auto Dispatch(Args... args) noexcept {
+    switch (GetSimdLevel()) {
+#if SIMD_X86_DISPATCH
+    case SimdLevel::AVX512:
+        return RunAvx512<Kernel>(args...);
+    case SimdLevel::AVX2:
+        return RunAvx2<Kernel>(args...);
+#endif
+#if SIMD_VECTOR_EXTENSIONS
+    case SimdLevel::SSE2:
+        return Kernel<16>::Run(args...);
+#endif
+    default:
+        return Kernel<0>::Run(args...);
+    }
+}
+
+template <template <size_t> class Kernel, typename... Args>
+inline auto DispatchCompare(SimdCompare cmp, Args... args) noexcept {
+    switch (cmp) {
+    case SimdCompare::EQUAL:
+        return Dispatch<Kernel>(args..., CompareTag<SimdCompare::EQUAL>{});
+    case SimdCompare::NOT_EQUAL:
+        return Dispatch<Kernel>(args..., CompareTag<SimdCompare::NOT_EQUAL>{});
+    case SimdCompare::LESS:
+        return Dispatch<Kernel>(args..., CompareTag<SimdCompare::LESS>{});
+    case SimdCompare::LESS_EQUAL:
+        return Dispatch<Kernel>(args..., CompareTag<SimdCompare::LESS_EQUAL>{});
+    case SimdCompare::GREATER:
+        return Dispatch<Kernel>(args..., CompareTag<SimdCompare::GREATER>{});
+    default:
+        return Dispatch<Kernel>(args..., CompareTag<SimdCompare::GREATER_EQUAL>{});
+    }
+}
+
+}  // namespace simd_detail
+
+//-------------------------SIMD_ALGORITHMS---------------------
+inline SimdLevel GetSimdLevel() noexcept {
+    static const SimdLevel detected = simd_detail::DetectSimdLevel();
+    const SimdLevel limit = simd_detail::max_simd_level.load(std::memory_order_relaxed);
+    return limit < detected ? limit : detected;
+}
+
+inline SimdLevel SetMaxSimdLevel(SimdLevel level) noexcept {
+    return simd_detail::max_simd_level.exchange(level, std::memory_order_relaxed);
+}
+
+template <typename T>
+inline T SimdSum(const T* data, size_t size) noexcept {
+    static_assert(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>);
+    return simd_detail::Dispatch<simd_detail::SumKernel>(data, size);
+}
+
+template <typename T>
+inline T SimdDot(const T* lhs, const T* rhs, size_t size) noexcept {
+    static_assert(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>);
+    return simd_detail::Dispatch<simd_detail::DotKernel>(lhs, rhs, size);
+}
+
+template <typename T>
+inline T SimdMin(const T* data, size_t size) noexcept {
+    static_assert(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>);
+    assert(size != 0);
+    return simd_detail::Dispatch<simd_detail::MinMaxKernel>(data, size, std::false_type{});
+}
+
+template <typename T>
+inline T SimdMax(const T* data, size_t size) noexcept {
+    static_assert(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>);
+    assert(size != 0);
+    return simd_detail::Dispatch<simd_detail::MinMaxKernel>(data, size, std::true_type{});
+}
+
+template <typename T>
+inline size_t SimdCount(const T* data, size_t size, SimdCompare cmp, T value) noexcept {
+    static_assert(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>);
+    return simd_detail::DispatchCompare<simd_detail::CountKernel>(cmp, data, size, value);
+}
+
+template <typename T>
+inline size_t SimdFind(const T* data, size_t size, SimdCompare cmp, T value) noexcept {
+    static_assert(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>);
+    return simd_detail::DispatchCompare<simd_detail::FindKernel>(cmp, data, size, value);
+}
+
+template <typename T>
+inline size_t SimdRemoveIf(T* data, size_t size, SimdCompare cmp, T value) noexcept {
+    static_assert(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>);
+    return simd_detail::DispatchCompare<simd_detail::RemoveIfKernel>(cmp, data, size, value);
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline T SimdSum(const Vector<T, Allocator, GrowthPolicy, StatsPolicy>& v) noexcept {
+    return SimdSum(v.Data(), v.Size());
+}
+
+template <typename T, typename AllocatorL, typename GrowthPolicyL, typename StatsPolicyL,
+          typename AllocatorR, typename GrowthPolicyR, typename StatsPolicyR>
+inline T SimdDot(const Vector<T, AllocatorL, GrowthPolicyL, StatsPolicyL>& lhs,
+                 const Vector<T, AllocatorR, GrowthPolicyR, StatsPolicyR>& rhs) noexcept {
+    assert(lhs.Size() == rhs.Size());
+    return SimdDot(lhs.Data(), rhs.Data(), lhs.Size());
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline T SimdMin(const Vector<T, Allocator, GrowthPolicy, StatsPolicy>& v) noexcept {
+    return SimdMin(v.Data(), v.Size());
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline T SimdMax(const Vector<T, Allocator, GrowthPolicy, StatsPolicy>& v) noexcept {
+    return SimdMax(v.Data(), v.Size());
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline size_t SimdCount(const Vector<T, Allocator, GrowthPolicy, StatsPolicy>& v, SimdCompare cmp, T value) noexcept {
+    return SimdCount(v.Data(), v.Size(), cmp, value);
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline size_t SimdFind(const Vector<T, Allocator, GrowthPolicy, StatsPolicy>& v, SimdCompare cmp, T value) noexcept {
+    return SimdFind(v.Data(), v.Size(), cmp, value);
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline size_t SimdEraseIf(Vector<T, Allocator, GrowthPolicy, StatsPolicy>& v, SimdCompare cmp, T value) {
+    const size_t size = v.Size();
+    const size_t kept = SimdRemoveIf(v.Data(), size, cmp, value);
+    v.Resize(kept);
+    return size - kept;
+}
+
+#undef SIMD_ALWAYS_INLINE
+#undef SIMD_VECTOR_EXTENSIONS
+#undef SIMD_X86_DISPATCH
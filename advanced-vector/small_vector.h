@@ -0,0 +1,506 @@
+#pragma once
+
+#include "vector.h"
+
+// Вектор, хранящий до N элементов внутри объекта. При превышении N элементы
+// переносятся в RawMemory, дальше контейнер ведёт себя как Vector
+template <typename T, size_t N, typename Allocator = std::allocator<T>, typename GrowthPolicy = DoublingGrowth>
+class SmallVector {
+    static_assert(N > 0, "Use Vector when no inline storage is needed");
+
+    using AllocTraits = std::allocator_traits<Allocator>;
+
+public:
+    using value_type = T;
+    using allocator_type = Allocator;
+
+    static constexpr size_t INLINE_CAPACITY = N;
+
+    SmallVector() = default;
+    ~SmallVector();
+
+    explicit SmallVector(const Allocator& alloc) noexcept;
+    explicit SmallVector(size_t size, const Allocator& alloc = Allocator());
+    explicit SmallVector(std::initializer_list<T> init_list, const Allocator& alloc = Allocator());
+
+    SmallVector(const SmallVector& other);
+    SmallVector(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>);
+
+    SmallVector& operator=(const SmallVector& other);
+    SmallVector& operator=(SmallVector&& other) noexcept(NOTHROW_MOVE_ASSIGNABLE);
+
+    const T& operator[](size_t index) const noexcept;
+    T& operator[](size_t index) noexcept;
+
+    const T& At(size_t index) const;
+    T& At(size_t index);
+
+    const T& Front() const noexcept;
+    T& Front() noexcept;
+
+    const T& Back() const noexcept;
+    T& Back() noexcept;
+
+    using iterator = T*;
+    using const_iterator = const T*;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+
+    iterator begin() noexcept;
+    iterator end() noexcept;
+    reverse_iterator rbegin() noexcept;
+    reverse_iterator rend() noexcept;
+    const_iterator begin() const noexcept;
+    const_iterator end() const noexcept;
+    const_iterator cbegin() const noexcept;
+    const_iterator cend() const noexcept;
+
+    size_t Capacity() const noexcept;
+    size_t Size() const noexcept;
+
+    // Элементы размещены во встроенном буфере, а не в куче
+    bool IsInline() const noexcept;
+
+    template<typename Value>
+    void PushBack(Value&& value);
+
+    template <typename... Args>
+    T& EmplaceBack(Args&&... args);
+
+    template <typename... Args>
+    iterator Emplace(const_iterator pos, Args&&... args);
+
+    iterator Insert(const_iterator pos, const T& value);
+    iterator Insert(const_iterator pos, T&& value);
+
+    void PopBack() noexcept;
+
+    iterator Erase(const_iterator pos) noexcept(std::is_nothrow_move_assignable_v<T>);
+
+    void Reserve(size_t new_capacity);
+    void Resize(size_t new_size);
+
+    void Swap(SmallVector& other);
+
+    bool Empty() const noexcept;
+
+    const Allocator& GetAllocator() const noexcept;
+
+private:
+    // Элементы из встроенного буфера other всегда помещаются в *this, поэтому выделение памяти
+    // при перемещающем присваивании возможно только при неравных аллокаторах
+    static constexpr bool NOTHROW_MOVE_ASSIGNABLE = std::is_nothrow_move_constructible_v<T>
+                                                    && (AllocTraits::propagate_on_container_move_assignment::value
+                                                        || AllocTraits::is_always_equal::value);
+
+    alignas(T) std::byte inline_data_[N * sizeof(T)];
+    // Пустой heap_ означает, что элементы хранятся в inline_data_
+    RawMemory<T, Allocator> heap_;
+    size_t size_ = 0;
+
+    T* Data() noexcept;
+    const T* Data() const noexcept;
+
+    // Переносит size_ элементов из текущего хранилища в new_data
+    void ReinicializationDataIn(RawMemory<T, Allocator>& new_data);
+
+    // Перемещает элементы other к себе; *this не должен содержать элементов
+    void MoveFrom(SmallVector& other);
+
+    // Присваивает count элементов, начиная с first, переиспользуя уже выделенную память
+    template<typename InIter>
+    void AssignFrom(InIter first, size_t count);
+};
+
+//-------------------------SMALL_VECTOR---------------------
+template <typename T, size_t N, typename Allocator, typename GrowthPolicy>
+inline SmallVector<T, N, Allocator, GrowthPolicy>::~SmallVector() {
+    std::destroy_n(Data(), size_);
+}
+
+template <typename T, size_t N, typename Allocator, typename GrowthPolicy>
+inline SmallVector<T, N, Allocator, GrowthPolicy>::SmallVector(const Allocator& alloc) noexcept : heap_(alloc) {
+}
+
+template <typename T, size_t N, typename Allocator, typename GrowthPolicy>
+inline SmallVector<T, N, Allocator, GrowthPolicy>::SmallVector(size_t size, const Allocator& alloc) : heap_(alloc) {
+    Reserve(size);
+    std::uninitialized_value_construct_n(Data(), size);
+    size_ = size;
+}
+
+template <typename T, size_t N, typename Allocator, typename GrowthPolicy>
+inline SmallVector<T, N, Allocator, GrowthPolicy>::SmallVector(std::initializer_list<T> init_list, const Allocator& alloc) : heap_(alloc) {
+    Reserve(init_list.size());
+    std::uninitialized_copy(init_list.begin(), init_list.end(), Data());
+    size_ = init_list.size();
+}
+
+template <typename T, size_t N, typename Allocator, typename GrowthPolicy>
+inline SmallVector<T, N, Allocator, GrowthPolicy>::SmallVector(const SmallVector& other)
+    : heap_(AllocTraits::select_on_container_copy_construction(other.GetAllocator())) {
+    Reserve(other.size_);
+    std::uninitialized_copy_n(other.Data(), other.size_, Data());
+    size_ = other.size_;
+}
+
+template <typename T, size_t N, typename Allocator, typename GrowthPolicy>
+inline SmallVector<T, N, Allocator, GrowthPolicy>::SmallVector(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+    : heap_(other.GetAllocator()) {
+    MoveFrom(other);
+}
+
+template <typename T, size_t N, typename Allocator, typename GrowthPolicy>
+inline SmallVector<T, N, Allocator, GrowthPolicy>& SmallVector<T, N, Allocator, GrowthPolicy>::operator=(const SmallVector& other) {
+    if (this != &other) {
+        if constexpr (AllocTraits::propagate_on_container_copy_assignment::value) {
+            if (heap_.GetAllocator() != other.heap_.GetAllocator()) {
+                // Память, выделенная прежним аллокатором, должна быть им же и освобождена
+                std::destroy_n(Data(), size_);
+                size_ = 0;
+                heap_.Reset(other.heap_.GetAllocator());
+            }
+        }
+
+        AssignFrom(other.begin(), other.size_);
+    }
+
+    return *this;
+}
+
+template <typename T, size_t N, typename Allocator, typename GrowthPolicy>
+inline SmallVector<T, N, Allocator, GrowthPolicy>& SmallVector<T, N, Allocator, GrowthPolicy>::operator=(SmallVector&& other) noexcept(NOTHROW_MOVE_ASSIGNABLE) {
+    if (this != &other) {
+        std::destroy_n(Data(), size_);
+        size_ = 0;
+        MoveFrom(other);
+    }
+
+    return *this;
+}
+
+template <typename T, size_t N, typename Allocator, typename GrowthPolicy>
+inline const T& SmallVector<T, N, Allocator, GrowthPolicy>::operator[](size_t index) const noexcept {
+    return const_cast<SmallVector&>(*this)[index];
+}
+
+template <typename T, size_t N, typename Allocator, typename GrowthPolicy>
+inline T& SmallVector<T, N, Allocator, GrowthPolicy>::operator[](size_t index) noexcept {
+    assert(index < size_);
+    return Data()[index];
+}
+
+template <typename T, size_t N, typename Allocator, typename GrowthPolicy>
+inline const T& SmallVector<T, N, Allocator, GrowthPolicy>::At(size_t index) const {
+    return const_cast<SmallVector&>(*this).At(index);
+}
+
+template <typename T, size_t N, typename Allocator, typename GrowthPolicy>
+inline T& SmallVector<T, N, Allocator, GrowthPolicy>::At(size_t index) {
+    if(index >= size_){
+        throw std::out_of_range("Out of vector range");
+    }
+
+    return Data()[index];
+}
+
+template <typename T, size_t N, typename Allocator, typename GrowthPolicy>
+inline const T& SmallVector<T, N, Allocator, GrowthPolicy>::Front() const noexcept {
+    return (*this)[0];
+}
+
+template <typename T, size_t N, typename Allocator, typename GrowthPolicy>
+inline T& SmallVector<T, N, Allocator, GrowthPolicy>::Front() noexcept {
+    return (*this)[0];
+}
+
+template <typename T, size_t N, typename Allocator, typename GrowthPolicy>
+inline const T& SmallVector<T, N, Allocator, GrowthPolicy>::Back() const noexcept {
+    return (*this)[size_ - 1];
+}
+
+template <typename T, size_t N, typename Allocator, typename GrowthPolicy>
+inline T& SmallVector<T, N, Allocator, GrowthPolicy>::Back() noexcept {
+    return (*this)[size_ - 1];
+}
+
+template <typename T, size_t N, typename Allocator, typename GrowthPolicy>
+inline typename SmallVector<T, N, Allocator, GrowthPolicy>::iterator SmallVector<T, N, Allocator, GrowthPolicy>::begin() noexcept {
+    return Data();
+}
+
+template <typename T, size_t N, typename Allocator, typename GrowthPolicy>
+inline typename SmallVector<T, N, Allocator, GrowthPolicy>::iterator SmallVector<T, N, Allocator, GrowthPolicy>::end() noexcept {
+    return Data() + size_;
+}
+
+template <typename T, size_t N, typename Allocator, typename GrowthPolicy>
+inline typename SmallVector<T, N, Allocator, GrowthPolicy>::reverse_iterator SmallVector<T, N, Allocator, GrowthPolicy>::rbegin() noexcept {
+    return reverse_iterator(end());
+}
+
+template <typename T, size_t N, typename Allocator, typename GrowthPolicy>
+inline typename SmallVector<T, N, Allocator, GrowthPolicy>::reverse_iterator SmallVector<T, N, Allocator, GrowthPolicy>::rend() noexcept {
+    return reverse_iterator(begin());
+}
+
+template <typename T, size_t N, typename Allocator, typename GrowthPolicy>
+inline typename SmallVector<T, N, Allocator, GrowthPolicy>::const_iterator SmallVector<T, N, Allocator, GrowthPolicy>::begin() const noexcept {
+    return Data();
+}
+
+template <typename T, size_t N, typename Allocator, typename GrowthPolicy>
+inline typename SmallVector<T, N, Allocator, GrowthPolicy>::const_iterator SmallVector<T, N, Allocator, GrowthPolicy>::end() const noexcept {
+    return Data() + size_;
+}
+
+template <typename T, size_t N, typename Allocator, typename GrowthPolicy>
+inline typename SmallVector<T, N, Allocator, GrowthPolicy>::const_iterator SmallVector<T, N, Allocator, GrowthPolicy>::cbegin() const noexcept {
+    return begin();
+}
+
+template <typename T, size_t N, typename Allocator, typename GrowthPolicy>
+inline typename SmallVector<T, N, Allocator, GrowthPolicy>::const_iterator SmallVector<T, N, Allocator, GrowthPolicy>::cend() const noexcept {
+    return end();
+}
+
+template <typename T, size_t N, typename Allocator, typename GrowthPolicy>
+inline size_t SmallVector<T, N, Allocator, GrowthPolicy>::Capacity() const noexcept {
+    return IsInline() ? N : heap_.Capacity();
+}
+
+template <typename T, size_t N, typename Allocator, typename GrowthPolicy>
+inline size_t SmallVector<T, N, Allocator, GrowthPolicy>::Size() const noexcept {
+    return size_;
+}
+
+template <typename T, size_t N, typename Allocator, typename GrowthPolicy>
+inline bool SmallVector<T, N, Allocator, GrowthPolicy>::IsInline() const noexcept {
+    return heap_.Capacity() == 0;
+}
+
+template <typename T, size_t N, typename Allocator, typename GrowthPolicy>
+template <typename Value>
+inline void SmallVector<T, N, Allocator, GrowthPolicy>::PushBack(Value&& value) {
+    EmplaceBack(std::forward<Value>(value));
+}
+
+template <typename T, size_t N, typename Allocator, typename GrowthPolicy>
+template <typename... Args>
+inline T& SmallVector<T, N, Allocator, GrowthPolicy>::EmplaceBack(Args&&... args) {
+    return *Emplace(end(), std::forward<Args>(args)...);
+}
+
+template <typename T, size_t N, typename Allocator, typename GrowthPolicy>
+template <typename... Args>
+inline typename SmallVector<T, N, Allocator, GrowthPolicy>::iterator SmallVector<T, N, Allocator, GrowthPolicy>::Emplace(const_iterator pos, Args&&... args) {
+    assert(pos >= begin() && pos <= end());
+
+    size_t range = pos - begin();
+    T* data = Data();
+    if(size_ < Capacity()) {
+
+        if(pos == end()) {
+            new(end()) T(std::forward<Args>(args)...);
+        } else if constexpr (IsTriviallyRelocatable<T>::value) {
+            // Элемент собирается во временном буфере: args могут ссылаться на элементы вектора
+            alignas(T) std::byte temp_value[sizeof(T)];
+            new (temp_value) T(std::forward<Args>(args)...);
+            RelocateN(data + range, size_ - range, data + range + 1);
+            RelocateN(reinterpret_cast<T*>(temp_value), 1, data + range);
+        } else {
+            T temp_value(std::forward<Args>(args)...);
+            new (end()) T(std::move(data[size_ - 1]));
+            std::move_backward(iterator(pos), end() - 1, end());
+            data[range] = std::move(temp_value);
+        }
+    } else {
+        RawMemory<T, Allocator> new_data(GrowthPolicy::NextCapacity(Capacity(), size_ + 1, sizeof(T)), heap_.GetAllocator());
+        new(new_data + range) T(std::forward<Args>(args)...);
+
+        if constexpr (IsTriviallyRelocatable<T>::value) {
+            RelocateN(data, range, new_data.GetAddress());
+            RelocateN(data + range, size_ - range, new_data + range + 1);
+        } else {
+            constexpr bool CAN_MOVE = std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>;
+            try {
+                if constexpr (CAN_MOVE) {
+                    std::uninitialized_move_n(data, range, new_data.GetAddress());
+                } else {
+                    std::uninitialized_copy_n(data, range, new_data.GetAddress());
+                }
+            } catch (...) {
+                std::destroy_at(new_data + range);
+                throw;
+            }
+
+            try {
+                if constexpr (CAN_MOVE) {
+                    std::uninitialized_move_n(data + range, size_ - range, new_data + range + 1);
+                } else {
+                    std::uninitialized_copy_n(data + range, size_ - range, new_data + range + 1);
+                }
+            } catch (...) {
+                std::destroy_n(new_data.GetAddress(), range + 1);
+                throw;
+            }
+
+            std::destroy_n(data, size_);
+        }
+        heap_.Swap(new_data);
+    }
+    ++size_;
+
+    return Data() + range;
+}
+
+template <typename T, size_t N, typename Allocator, typename GrowthPolicy>
+inline typename SmallVector<T, N, Allocator, GrowthPolicy>::iterator SmallVector<T, N, Allocator, GrowthPolicy>::Insert(const_iterator pos, const T& value) {
+    return Emplace(pos, value);
+}
+
+template <typename T, size_t N, typename Allocator, typename GrowthPolicy>
+inline typename SmallVector<T, N, Allocator, GrowthPolicy>::iterator SmallVector<T, N, Allocator, GrowthPolicy>::Insert(const_iterator pos, T&& value) {
+    return Emplace(pos, std::move(value));
+}
+
+template <typename T, size_t N, typename Allocator, typename GrowthPolicy>
+inline void SmallVector<T, N, Allocator, GrowthPolicy>::PopBack() noexcept {
+    assert(!Empty());
+
+    std::destroy_at(Data() + (size_ - 1));
+    --size_;
+}
+
+template <typename T, size_t N, typename Allocator, typename GrowthPolicy>
+inline typename SmallVector<T, N, Allocator, GrowthPolicy>::iterator SmallVector<T, N, Allocator, GrowthPolicy>::Erase(const_iterator pos) noexcept(std::is_nothrow_move_assignable_v<T>) {
+    assert(pos >= begin() && pos < end());
+
+    if constexpr (IsTriviallyRelocatable<T>::value) {
+        std::destroy_at(iterator(pos));
+        RelocateN(iterator(pos) + 1, end() - pos - 1, iterator(pos));
+        --size_;
+    } else {
+        std::move(iterator(pos) + 1, end(), iterator(pos));
+        PopBack();
+    }
+
+    return iterator(pos);
+}
+
+template <typename T, size_t N, typename Allocator, typename GrowthPolicy>
+inline void SmallVector<T, N, Allocator, GrowthPolicy>::Reserve(size_t new_capacity) {
+    if (new_capacity <= Capacity()) {
+        return;
+    }
+
+    RawMemory<T, Allocator> new_data(new_capacity, heap_.GetAllocator());
+    ReinicializationDataIn(new_data);
+}
+
+template <typename T, size_t N, typename Allocator, typename GrowthPolicy>
+inline void SmallVector<T, N, Allocator, GrowthPolicy>::Resize(size_t new_size) {
+    if(new_size <= size_) {
+        std::destroy_n(Data() + new_size, size_ - new_size);
+    } else {
+        Reserve(new_size);
+        std::uninitialized_value_construct_n(Data() + size_, new_size - size_);
+    }
+
+    size_ = new_size;
+}
+
+template <typename T, size_t N, typename Allocator, typename GrowthPolicy>
+inline void SmallVector<T, N, Allocator, GrowthPolicy>::Swap(SmallVector& other) {
+    if (!IsInline() && !other.IsInline()) {
+        heap_.Swap(other.heap_);
+        std::swap(size_, other.size_);
+        return;
+    }
+
+    SmallVector temp(std::move(other));
+    other = std::move(*this);
+    *this = std::move(temp);
+}
+
+template <typename T, size_t N, typename Allocator, typename GrowthPolicy>
+inline bool SmallVector<T, N, Allocator, GrowthPolicy>::Empty() const noexcept {
+    return size_ == 0;
+}
+
+template <typename T, size_t N, typename Allocator, typename GrowthPolicy>
+inline const Allocator& SmallVector<T, N, Allocator, GrowthPolicy>::GetAllocator() const noexcept {
+    return heap_.GetAllocator();
+}
+
+template <typename T, size_t N, typename Allocator, typename GrowthPolicy>
+inline T* SmallVector<T, N, Allocator, GrowthPolicy>::Data() noexcept {
+    return IsInline() ? reinterpret_cast<T*>(inline_data_) : heap_.GetAddress();
+}
+
+template <typename T, size_t N, typename Allocator, typename GrowthPolicy>
+inline const T* SmallVector<T, N, Allocator, GrowthPolicy>::Data() const noexcept {
+    return const_cast<SmallVector&>(*this).Data();
+}
+
+template <typename T, size_t N, typename Allocator, typename GrowthPolicy>
+inline void SmallVector<T, N, Allocator, GrowthPolicy>::ReinicializationDataIn(RawMemory<T, Allocator>& new_data) {
+    if constexpr (IsTriviallyRelocatable<T>::value) {
+        RelocateN(Data(), size_, new_data.GetAddress());
+    } else {
+        if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
+            std::uninitialized_move_n(Data(), size_, new_data.GetAddress());
+        } else {
+            std::uninitialized_copy_n(Data(), size_, new_data.GetAddress());
+        }
+
+        std::destroy_n(Data(), size_);
+    }
+    heap_.Swap(new_data);
+}
+
+template <typename T, size_t N, typename Allocator, typename GrowthPolicy>
+inline void SmallVector<T, N, Allocator, GrowthPolicy>::MoveFrom(SmallVector& other) {
+    assert(size_ == 0);
+
+    bool can_steal = !other.IsInline();
+    if constexpr (!AllocTraits::propagate_on_container_move_assignment::value && !AllocTraits::is_always_equal::value) {
+        can_steal = can_steal && heap_.GetAllocator() == other.heap_.GetAllocator();
+    }
+
+    if (can_steal) {
+        heap_ = std::move(other.heap_);
+    } else {
+        // Встроенный буфер нельзя забрать: элементы перемещаются по одному
+        Reserve(other.size_);
+        if constexpr (IsTriviallyRelocatable<T>::value) {
+            RelocateN(other.Data(), other.size_, Data());
+        } else {
+            std::uninitialized_move_n(other.Data(), other.size_, Data());
+            std::destroy_n(other.Data(), other.size_);
+        }
+    }
+    size_ = std::exchange(other.size_, 0);
+}
+
+template <typename T, size_t N, typename Allocator, typename GrowthPolicy>
+template <typename InIter>
+inline void SmallVector<T, N, Allocator, GrowthPolicy>::AssignFrom(InIter first, size_t count) {
+    if (count > Capacity()) {
+        RawMemory<T, Allocator> new_data(count, heap_.GetAllocator());
+        std::uninitialized_copy_n(first, count, new_data.GetAddress());
+
+        std::destroy_n(Data(), size_);
+        heap_.Swap(new_data);
+    } else {
+        const size_t common = std::min(count, size_);
+        std::copy_n(first, common, Data());
+
+        if(count < size_) {
+            std::destroy_n(Data() + count, size_ - count);
+        } else {
+            std::advance(first, common);
+            std::uninitialized_copy_n(first, count - size_, Data() + size_);
+        }
+    }
+    size_ = count;
+}
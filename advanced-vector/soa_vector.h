@@ -0,0 +1,562 @@
+#pragma once
+
+#include "vector.h"
+
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+// Непрерывный участок одного столбца SoaVector
+template <typename T>
+using SoaColumn = Span<T>;
+
+// Вектор записей, хранящий каждое поле в отдельном буфере RawMemory (structure of arrays).
+// Все столбцы имеют общие размер, ёмкость и путь роста, поэтому цикл по одному полю
+// читает только его данные и векторизуется компилятором. Элемент доступен как кортеж
+// ссылок на поля, итератор возвращает такой кортеж по значению
+template <typename... Fields>
+class SoaVector {
+    static_assert(sizeof...(Fields) > 0, "SoaVector needs at least one field");
+
+    template <bool IsConst>
+    class Iterator;
+
+public:
+    using value_type = std::tuple<Fields...>;
+    using reference = std::tuple<Fields&...>;
+    using const_reference = std::tuple<const Fields&...>;
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    template <size_t I>
+    using FieldType = std::tuple_element_t<I, value_type>;
+
+    static constexpr size_t FIELD_COUNT = sizeof...(Fields);
+
+    SoaVector() = default;
+    ~SoaVector();
+
+    explicit SoaVector(size_t size);
+
+    SoaVector(const SoaVector& other);
+    SoaVector(SoaVector&& other) noexcept;
+
+    SoaVector& operator=(const SoaVector& other);
+    SoaVector& operator=(SoaVector&& other) noexcept;
+
+    reference operator[](size_t index) noexcept;
+    const_reference operator[](size_t index) const noexcept;
+
+    // Столбец поля I целиком: указатель на данные и размер
+    template <size_t I>
+    SoaColumn<FieldType<I>> Column() noexcept;
+    template <size_t I>
+    SoaColumn<const FieldType<I>> Column() const noexcept;
+
+    iterator begin() noexcept;
+    iterator end() noexcept;
+    const_iterator begin() const noexcept;
+    const_iterator end() const noexcept;
+    const_iterator cbegin() const noexcept;
+    const_iterator cend() const noexcept;
+
+    size_t Capacity() const noexcept;
+    size_t Size() const noexcept;
+    bool Empty() const noexcept;
+
+    void PushBack(const value_type& value);
+    void PushBack(value_type&& value);
+
+    // По одному аргументу на каждое поле
+    template <typename... Args>
+    reference EmplaceBack(Args&&... args);
+
+    void PopBack() noexcept;
+
+    void Reserve(size_t new_capacity);
+    void Resize(size_t new_size);
+    void Clear() noexcept;
+
+    void Swap(SoaVector& other) noexcept;
+
+private:
+    using Indices = std::index_sequence_for<Fields...>;
+
+    // Столбец переносится копированием, если его нельзя переместить без исключений
+    template <typename T>
+    static constexpr bool COPIES_ON_GROWTH = !IsTriviallyRelocatable<T>::value
+                                             && !std::is_nothrow_move_constructible_v<T>
+                                             && std::is_copy_constructible_v<T>;
+    // Некопируемый столбец с бросающим перемещением: как и Vector, SoaVector даёт для него
+    // только базовую гарантию - при исключении часть его элементов остаётся перемещённой
+    template <typename T>
+    static constexpr bool MOVES_WITH_THROW = !IsTriviallyRelocatable<T>::value
+                                             && !std::is_nothrow_move_constructible_v<T>
+                                             && !std::is_copy_constructible_v<T>;
+
+    std::tuple<RawMemory<Fields>...> columns_;
+    size_t size_ = 0;
+    size_t capacity_ = 0;
+
+    template <size_t I>
+    FieldType<I>* Data() noexcept;
+    template <size_t I>
+    const FieldType<I>* Data() const noexcept;
+
+    template <size_t... I>
+    reference Row(size_t index, std::index_sequence<I...>) noexcept;
+    template <size_t... I>
+    const_reference Row(size_t index, std::index_sequence<I...>) const noexcept;
+
+    // Строит поля элемента index начиная с поля I; при исключении уже построенные поля уничтожаются
+    template <size_t I, typename Arg, typename... Rest>
+    void ConstructFields(size_t index, Arg&& arg, Rest&&... rest);
+
+    // Применяет op(column) к каждому столбцу начиная с I; если op бросит исключение,
+    // для уже обработанных столбцов вызывается rollback(column)
+    template <size_t I, typename Operation, typename Rollback>
+    void ForEachColumn(Operation& op, Rollback& rollback);
+
+    template <size_t... I>
+    void DestroyRange(size_t first, size_t last, std::index_sequence<I...>) noexcept;
+
+    template <typename T>
+    static void TransferColumn(RawMemory<T>& from, RawMemory<T>& to, size_t count) noexcept;
+
+    template <size_t... I>
+    void Reallocate(size_t new_capacity, std::index_sequence<I...>);
+};
+
+template <typename... Fields>
+template <bool IsConst>
+class SoaVector<Fields...>::Iterator {
+    using Owner = std::conditional_t<IsConst, const SoaVector, SoaVector>;
+
+public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = typename SoaVector::value_type;
+    using difference_type = std::ptrdiff_t;
+    using reference = std::conditional_t<IsConst, typename SoaVector::const_reference, typename SoaVector::reference>;
+    using pointer = void;
+
+    Iterator() = default;
+    Iterator(Owner* owner, size_t index) noexcept : owner_(owner),
+                                                    index_(index) {
+    }
+
+    template <bool OtherConst, typename = std::enable_if_t<IsConst && !OtherConst>>
+    Iterator(const Iterator<OtherConst>& other) noexcept : owner_(other.owner_),
+                                                           index_(other.index_) {
+    }
+
+    reference operator*() const noexcept {
+        return (*owner_)[index_];
+    }
+    reference operator[](difference_type offset) const noexcept {
+        return (*owner_)[index_ + offset];
+    }
+
+    // Номер элемента: удобен для доступа к столбцам, не входящим в кортеж
+    size_t Index() const noexcept {
+        return index_;
+    }
+
+    Iterator& operator++() noexcept {
+        ++index_;
+        return *this;
+    }
+    Iterator operator++(int) noexcept {
+        Iterator result = *this;
+        ++index_;
+        return result;
+    }
+    Iterator& operator--() noexcept {
+        --index_;
+        return *this;
+    }
+    Iterator operator--(int) noexcept {
+        Iterator result = *this;
+        --index_;
+        return result;
+    }
+
+    Iterator& operator+=(difference_type offset) noexcept {
+        index_ += offset;
+        return *this;
+    }
+    Iterator& operator-=(difference_type offset) noexcept {
+        index_ -= offset;
+        return *this;
+    }
+
+    friend Iterator operator+(Iterator it, difference_type offset) noexcept {
+        return it += offset;
+    }
+    friend Iterator operator+(difference_type offset, Iterator it) noexcept {
+        return it += offset;
+    }
+    friend Iterator operator-(Iterator it, difference_type offset) noexcept {
+        return it -= offset;
+    }
+    friend difference_type operator-(const Iterator& lhs, const Iterator& rhs) noexcept {
+        return static_cast<difference_type>(lhs.index_) - static_cast<difference_type>(rhs.index_);
+    }
+
+    friend bool operator==(const Iterator& lhs, const Iterator& rhs) noexcept {
+        return lhs.index_ == rhs.index_;
+    }
+    friend bool operator!=(const Iterator& lhs, const Iterator& rhs) noexcept {
+        return lhs.index_ != rhs.index_;
+    }
+    friend bool operator<(const Iterator& lhs, const Iterator& rhs) noexcept {
+        return lhs.index_ < rhs.index_;
+    }
+    friend bool operator>(const Iterator& lhs, const Iterator& rhs) noexcept {
+        return lhs.index_ > rhs.index_;
+    }
+    friend bool operator<=(const Iterator& lhs, const Iterator& rhs) noexcept {
+        return lhs.index_ <= rhs.index_;
+    }
+    friend bool operator>=(const Iterator& lhs, const Iterator& rhs) noexcept {
+        return lhs.index_ >= rhs.index_;
+    }
+
+private:
+    template <bool OtherConst>
+    friend class Iterator;
+
+    Owner* owner_ = nullptr;
+    size_t index_ = 0;
+};
+
+//-------------------------SOA_VECTOR---------------------
+template <typename... Fields>
+inline SoaVector<Fields...>::~SoaVector() {
+    Clear();
+}
+
+template <typename... Fields>
+inline SoaVector<Fields...>::SoaVector(size_t size) {
+    Resize(size);
+}
+
+template <typename... Fields>
+inline SoaVector<Fields...>::SoaVector(const SoaVector& other) {
+    Reserve(other.size_);
+
+    auto copy_column = [this, &other](auto index) {
+        constexpr size_t I = decltype(index)::value;
+        std::uninitialized_copy_n(other.template Data<I>(), other.size_, Data<I>());
+    };
+    auto destroy_column = [this, &other](auto index) {
+        constexpr size_t I = decltype(index)::value;
+        std::destroy_n(Data<I>(), other.size_);
+    };
+    ForEachColumn<0>(copy_column, destroy_column);
+    size_ = other.size_;
+}
+
+template <typename... Fields>
+inline SoaVector<Fields...>::SoaVector(SoaVector&& other) noexcept : columns_(std::move(other.columns_)),
+                                                                     size_(std::exchange(other.size_, 0)),
+                                                                     capacity_(std::exchange(other.capacity_, 0)) {
+}
+
+template <typename... Fields>
+inline SoaVector<Fields...>& SoaVector<Fields...>::operator=(const SoaVector& other) {
+    if (this != &other) {
+        SoaVector copy(other);
+        Swap(copy);
+    }
+    return *this;
+}
+
+template <typename... Fields>
+inline SoaVector<Fields...>& SoaVector<Fields...>::operator=(SoaVector&& other) noexcept {
+    if (this != &other) {
+        SoaVector moved(std::move(other));
+        Swap(moved);
+    }
+    return *this;
+}
+
+template <typename... Fields>
+inline typename SoaVector<Fields...>::reference SoaVector<Fields...>::operator[](size_t index) noexcept {
+    assert(index < size_);
+    return Row(index, Indices{});
+}
+
+template <typename... Fields>
+inline typename SoaVector<Fields...>::const_reference SoaVector<Fields...>::operator[](size_t index) const noexcept {
+    assert(index < size_);
+    return Row(index, Indices{});
+}
+
+template <typename... Fields>
+template <size_t I>
+inline SoaColumn<typename SoaVector<Fields...>::template FieldType<I>> SoaVector<Fields...>::Column() noexcept {
+    return {Data<I>(), size_};
+}
+
+template <typename... Fields>
+template <size_t I>
+inline SoaColumn<const typename SoaVector<Fields...>::template FieldType<I>> SoaVector<Fields...>::Column() const noexcept {
+    return {Data<I>(), size_};
+}
+
+template <typename... Fields>
+inline typename SoaVector<Fields...>::iterator SoaVector<Fields...>::begin() noexcept {
+    return iterator(this, 0);
+}
+
+template <typename... Fields>
+inline typename SoaVector<Fields...>::iterator SoaVector<Fields...>::end() noexcept {
+    return iterator(this, size_);
+}
+
+template <typename... Fields>
+inline typename SoaVector<Fields...>::const_iterator SoaVector<Fields...>::begin() const noexcept {
+    return const_iterator(this, 0);
+}
+
+template <typename... Fields>
+inline typename SoaVector<Fields...>::const_iterator SoaVector<Fields...>::end() const noexcept {
+    return const_iterator(this, size_);
+}
+
+template <typename... Fields>
+inline typename SoaVector<Fields...>::const_iterator SoaVector<Fields...>::cbegin() const noexcept {
+    return begin();
+}
+
+template <typename... Fields>
+inline typename SoaVector<Fields...>::const_iterator SoaVector<Fields...>::cend() const noexcept {
+    return end();
+}
+
+template <typename... Fields>
+inline size_t SoaVector<Fields...>::Capacity() const noexcept {
+    return capacity_;
+}
+
+template <typename... Fields>
+inline size_t SoaVector<Fields...>::Size() const noexcept {
+    return size_;
+}
+
+template <typename... Fields>
+inline bool SoaVector<Fields...>::Empty() const noexcept {
+    return size_ == 0;
+}
+
+template <typename... Fields>
+inline void SoaVector<Fields...>::PushBack(const value_type& value) {
+    std::apply([this](const Fields&... fields) {
+        EmplaceBack(fields...);
+    }, value);
+}
+
+template <typename... Fields>
+inline void SoaVector<Fields...>::PushBack(value_type&& value) {
+    std::apply([this](Fields&... fields) {
+        EmplaceBack(std::move(fields)...);
+    }, value);
+}
+
+template <typename... Fields>
+template <typename... Args>
+inline typename SoaVector<Fields...>::reference SoaVector<Fields...>::EmplaceBack(Args&&... args) {
+    static_assert(sizeof...(Args) == sizeof...(Fields), "EmplaceBack takes one argument per field");
+
+    if (size_ == capacity_) {
+        // Аргументы могут ссылаться на элементы вектора: поля строятся до переноса столбцов
+        value_type value(std::forward<Args>(args)...);
+        Reserve(DoublingGrowth::NextCapacity(capacity_, size_ + 1, (sizeof(Fields) + ...)));
+        std::apply([this](Fields&... fields) {
+            ConstructFields<0>(size_, std::move(fields)...);
+        }, value);
+    } else {
+        ConstructFields<0>(size_, std::forward<Args>(args)...);
+    }
+
+    return Row(size_++, Indices{});
+}
+
+template <typename... Fields>
+inline void SoaVector<Fields...>::PopBack() noexcept {
+    assert(size_ != 0);
+    DestroyRange(size_ - 1, size_, Indices{});
+    --size_;
+}
+
+template <typename... Fields>
+inline void SoaVector<Fields...>::Reserve(size_t new_capacity) {
+    if (new_capacity > capacity_) {
+        Reallocate(new_capacity, Indices{});
+    }
+}
+
+template <typename... Fields>
+inline void SoaVector<Fields...>::Resize(size_t new_size) {
+    if (new_size <= size_) {
+        DestroyRange(new_size, size_, Indices{});
+        size_ = new_size;
+        return;
+    }
+
+    Reserve(new_size);
+    auto construct = [this, new_size](auto index) {
+        constexpr size_t I = decltype(index)::value;
+        std::uninitialized_value_construct_n(Data<I>() + size_, new_size - size_);
+    };
+    auto destroy = [this, new_size](auto index) {
+        constexpr size_t I = decltype(index)::value;
+        std::destroy_n(Data<I>() + size_, new_size - size_);
+    };
+    ForEachColumn<0>(construct, destroy);
+    size_ = new_size;
+}
+
+template <typename... Fields>
+inline void SoaVector<Fields...>::Clear() noexcept {
+    DestroyRange(0, size_, Indices{});
+    size_ = 0;
+}
+
+template <typename... Fields>
+inline void SoaVector<Fields...>::Swap(SoaVector& other) noexcept {
+    std::apply([&other](auto&... columns) {
+        std::apply([&columns...](auto&... other_columns) {
+            (columns.Swap(other_columns), ...);
+        }, other.columns_);
+    }, columns_);
+    std::swap(size_, other.size_);
+    std::swap(capacity_, other.capacity_);
+}
+
+template <typename... Fields>
+template <size_t I>
+inline typename SoaVector<Fields...>::template FieldType<I>* SoaVector<Fields...>::Data() noexcept {
+    return std::get<I>(columns_).GetAddress();
+}
+
+template <typename... Fields>
+template <size_t I>
+inline const typename SoaVector<Fields...>::template FieldType<I>* SoaVector<Fields...>::Data() const noexcept {
+    return std::get<I>(columns_).GetAddress();
+}
+
+template <typename... Fields>
+template <size_t... I>
+inline typename SoaVector<Fields...>::reference SoaVector<Fields...>::Row(size_t index, std::index_sequence<I...>) noexcept {
+    return reference(Data<I>()[index]...);
+}
+
+template <typename... Fields>
+template <size_t... I>
+inline typename SoaVector<Fields...>::const_reference SoaVector<Fields...>::Row(size_t index, std::index_sequence<I...>) const noexcept {
+    return const_reference(Data<I>()[index]...);
+}
+
+template <typename... Fields>
+template <size_t I, typename Arg, typename... Rest>
+inline void SoaVector<Fields...>::ConstructFields(size_t index, Arg&& arg, Rest&&... rest) {
+    new (Data<I>() + index) FieldType<I>(std::forward<Arg>(arg));
+
+    if constexpr (sizeof...(Rest) > 0) {
+        try {
+            ConstructFields<I + 1>(index, std::forward<Rest>(rest)...);
+        } catch (...) {
+            std::destroy_at(Data<I>() + index);
+            throw;
+        }
+    }
+}
+
+template <typename... Fields>
+template <size_t I, typename Operation, typename Rollback>
+inline void SoaVector<Fields...>::ForEachColumn(Operation& op, Rollback& rollback) {
+    op(std::integral_constant<size_t, I>{});
+
+    if constexpr (I + 1 < sizeof...(Fields)) {
+        try {
+            ForEachColumn<I + 1>(op, rollback);
+        } catch (...) {
+            rollback(std::integral_constant<size_t, I>{});
+            throw;
+        }
+    }
+}
+
+template <typename... Fields>
+template <size_t... I>
+inline void SoaVector<Fields...>::DestroyRange(size_t first, size_t last, std::index_sequence<I...>) noexcept {
+    (std::destroy(Data<I>() + first, Data<I>() + last), ...);
+}
+
+template <typename... Fields>
+template <typename T>
+inline void SoaVector<Fields...>::TransferColumn(RawMemory<T>& from, RawMemory<T>& to, size_t count) noexcept {
+    if constexpr (IsTriviallyRelocatable<T>::value) {
+        RelocateN(from.GetAddress(), count, to.GetAddress());
+    } else if constexpr (COPIES_ON_GROWTH<T> || MOVES_WITH_THROW<T>) {
+        // Столбец уже скопирован или перемещён в to, остаётся уничтожить оригиналы
+        std::destroy_n(from.GetAddress(), count);
+    } else {
+        std::uninitialized_move_n(from.GetAddress(), count, to.GetAddress());
+        std::destroy_n(from.GetAddress(), count);
+    }
+}
+
+template <typename... Fields>
+template <size_t... I>
+inline void SoaVector<Fields...>::Reallocate(size_t new_capacity, std::index_sequence<I...>) {
+    std::tuple<RawMemory<Fields>...> new_columns{RawMemory<Fields>(new_capacity)...};
+
+    // Сначала переносятся столбцы, перенос которых может бросить исключение: до их
+    // завершения старые буферы не освобождаются. Копируемые столбцы идут первыми, чтобы
+    // при их сбое ни один элемент не был перемещён
+    auto copy = [this, &new_columns](auto index) {
+        constexpr size_t J = decltype(index)::value;
+        if constexpr (COPIES_ON_GROWTH<FieldType<J>>) {
+            std::uninitialized_copy_n(Data<J>(), size_, std::get<J>(new_columns).GetAddress());
+        }
+    };
+    auto undo_copy = [this, &new_columns](auto index) {
+        constexpr size_t J = decltype(index)::value;
+        if constexpr (COPIES_ON_GROWTH<FieldType<J>>) {
+            std::destroy_n(std::get<J>(new_columns).GetAddress(), size_);
+        }
+    };
+    ForEachColumn<0>(copy, undo_copy);
+
+    if constexpr ((MOVES_WITH_THROW<Fields> || ...)) {
+        auto move = [this, &new_columns](auto index) {
+            constexpr size_t J = decltype(index)::value;
+            if constexpr (MOVES_WITH_THROW<FieldType<J>>) {
+                std::uninitialized_move_n(Data<J>(), size_, std::get<J>(new_columns).GetAddress());
+            }
+        };
+        auto undo_move = [this, &new_columns](auto index) {
+            constexpr size_t J = decltype(index)::value;
+            if constexpr (MOVES_WITH_THROW<FieldType<J>>) {
+                std::destroy_n(std::get<J>(new_columns).GetAddress(), size_);
+            }
+        };
+        try {
+            ForEachColumn<0>(move, undo_move);
+        } catch (...) {
+            (undo_copy(std::integral_constant<size_t, I>{}), ...);
+            throw;
+        }
+    }
+
+    (TransferColumn(std::get<I>(columns_), std::get<I>(new_columns), size_), ...);
+    (std::get<I>(columns_).Swap(std::get<I>(new_columns)), ...);
+    capacity_ = new_capacity;
+}
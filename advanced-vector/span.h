@@ -0,0 +1,261 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+#if __cplusplus >= 202002L && __has_include(<ranges>)
+#include <ranges>
+#endif
+
+// Невладеющие представления непрерывных участков памяти. Индексы и границы подотрезков
+// проверяются через assert, то есть только в отладочной сборке.
+// Span предоставляет begin() и end() в виде указателей, поэтому в C++20 из него строится
+// std::span<T> конструктором от диапазона
+
+// Размер подотрезка "до конца"
+inline constexpr size_t DYNAMIC_EXTENT = static_cast<size_t>(-1);
+
+template <typename T>
+class StridedSpan;
+
+template <typename T>
+class Span {
+public:
+    using element_type = T;
+    using value_type = std::remove_cv_t<T>;
+    using iterator = T*;
+
+    constexpr Span() noexcept = default;
+    constexpr Span(T* data, size_t size) noexcept : data_(data),
+                                                   size_(size) {
+    }
+    // Span<T> приводится к Span<const T>
+    template <typename U, typename = std::enable_if_t<std::is_convertible_v<U (*)[], T (*)[]>>>
+    constexpr Span(const Span<U>& other) noexcept : data_(other.Data()),
+                                                   size_(other.Size()) {
+    }
+
+    constexpr T* Data() const noexcept {
+        return data_;
+    }
+    constexpr size_t Size() const noexcept {
+        return size_;
+    }
+    constexpr size_t SizeBytes() const noexcept {
+        return size_ * sizeof(T);
+    }
+    constexpr bool Empty() const noexcept {
+        return size_ == 0;
+    }
+
+    constexpr T& operator[](size_t index) const noexcept {
+        assert(index < size_);
+        return data_[index];
+    }
+    constexpr T& Front() const noexcept {
+        return (*this)[0];
+    }
+    constexpr T& Back() const noexcept {
+        return (*this)[size_ - 1];
+    }
+
+    constexpr T* begin() const noexcept {
+        return data_;
+    }
+    constexpr T* end() const noexcept {
+        return data_ + size_;
+    }
+
+    // Первые и последние count элементов
+    constexpr Span First(size_t count) const noexcept {
+        assert(count <= size_);
+        return Span(data_, count);
+    }
+    constexpr Span Last(size_t count) const noexcept {
+        assert(count <= size_);
+        return Span(data_ + (size_ - count), count);
+    }
+    // count элементов начиная с offset, по умолчанию - до конца
+    constexpr Span Subspan(size_t offset, size_t count = DYNAMIC_EXTENT) const noexcept {
+        assert(offset <= size_);
+        assert(count == DYNAMIC_EXTENT || count <= size_ - offset);
+        return Span(data_ + offset, count == DYNAMIC_EXTENT ? size_ - offset : count);
+    }
+
+    // Каждый stride-й элемент, начиная с первого
+    constexpr StridedSpan<T> Strided(size_t stride) const noexcept;
+
+private:
+    T* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+// Представление size элементов, отстоящих друг от друга на stride элементов
+template <typename T>
+class StridedSpan {
+    class Iterator;
+
+public:
+    using element_type = T;
+    using value_type = std::remove_cv_t<T>;
+    using iterator = Iterator;
+
+    constexpr StridedSpan() noexcept = default;
+    // Элементы data[0], data[stride], ..., data[(size - 1) * stride]
+    constexpr StridedSpan(T* data, size_t size, size_t stride) noexcept : data_(data),
+                                                                         size_(size),
+                                                                         stride_(stride) {
+        assert(stride != 0);
+    }
+
+    constexpr T* Data() const noexcept {
+        return data_;
+    }
+    constexpr size_t Size() const noexcept {
+        return size_;
+    }
+    constexpr size_t Stride() const noexcept {
+        return stride_;
+    }
+    constexpr bool Empty() const noexcept {
+        return size_ == 0;
+    }
+
+    constexpr T& operator[](size_t index) const noexcept {
+        assert(index < size_);
+        return data_[index * stride_];
+    }
+
+    constexpr iterator begin() const noexcept {
+        return iterator(data_, stride_, 0);
+    }
+    constexpr iterator end() const noexcept {
+        return iterator(data_, stride_, size_);
+    }
+
+    // count элементов представления начиная с offset. Пустое представление с offset == Size()
+    // сохраняет data_: адрес data_ + offset * stride_ может лежать за концом буфера
+    constexpr StridedSpan Subspan(size_t offset, size_t count = DYNAMIC_EXTENT) const noexcept {
+        assert(offset <= size_);
+        assert(count == DYNAMIC_EXTENT || count <= size_ - offset);
+        if (offset == size_) {
+            return StridedSpan(data_, 0, stride_);
+        }
+        return StridedSpan(data_ + offset * stride_, count == DYNAMIC_EXTENT ? size_ - offset : count, stride_);
+    }
+
+private:
+    T* data_ = nullptr;
+    size_t size_ = 0;
+    size_t stride_ = 1;
+};
+
+// Итератор хранит номер элемента, а не указатель, чтобы end() не выходил за пределы буфера
+template <typename T>
+class StridedSpan<T>::Iterator {
+public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = std::remove_cv_t<T>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = T*;
+    using reference = T&;
+
+    constexpr Iterator() noexcept = default;
+    constexpr Iterator(T* data, size_t stride, size_t index) noexcept : data_(data),
+                                                                       stride_(stride),
+                                                                       index_(index) {
+    }
+
+    constexpr reference operator*() const noexcept {
+        return data_[index_ * stride_];
+    }
+    constexpr pointer operator->() const noexcept {
+        return data_ + index_ * stride_;
+    }
+    constexpr reference operator[](difference_type offset) const noexcept {
+        return *(*this + offset);
+    }
+
+    constexpr Iterator& operator++() noexcept {
+        ++index_;
+        return *this;
+    }
+    constexpr Iterator operator++(int) noexcept {
+        Iterator copy = *this;
+        ++index_;
+        return copy;
+    }
+    constexpr Iterator& operator--() noexcept {
+        --index_;
+        return *this;
+    }
+    constexpr Iterator operator--(int) noexcept {
+        Iterator copy = *this;
+        --index_;
+        return copy;
+    }
+
+    constexpr Iterator& operator+=(difference_type offset) noexcept {
+        index_ += offset;
+        return *this;
+    }
+    constexpr Iterator& operator-=(difference_type offset) noexcept {
+        index_ -= offset;
+        return *this;
+    }
+    constexpr friend Iterator operator+(Iterator it, difference_type offset) noexcept {
+        return it += offset;
+    }
+    constexpr friend Iterator operator+(difference_type offset, Iterator it) noexcept {
+        return it += offset;
+    }
+    constexpr friend Iterator operator-(Iterator it, difference_type offset) noexcept {
+        return it -= offset;
+    }
+    constexpr friend difference_type operator-(const Iterator& lhs, const Iterator& rhs) noexcept {
+        return static_cast<difference_type>(lhs.index_) - static_cast<difference_type>(rhs.index_);
+    }
+
+    constexpr friend bool operator==(const Iterator& lhs, const Iterator& rhs) noexcept {
+        return lhs.index_ == rhs.index_;
+    }
+    constexpr friend bool operator!=(const Iterator& lhs, const Iterator& rhs) noexcept {
+        return lhs.index_ != rhs.index_;
+    }
+    constexpr friend bool operator<(const Iterator& lhs, const Iterator& rhs) noexcept {
+        return lhs.index_ < rhs.index_;
+    }
+    constexpr friend bool operator>(const Iterator& lhs, const Iterator& rhs) noexcept {
+        return rhs < lhs;
+    }
+    constexpr friend bool operator<=(const Iterator& lhs, const Iterator& rhs) noexcept {
+        return !(rhs < lhs);
+    }
+    constexpr friend bool operator>=(const Iterator& lhs, const Iterator& rhs) noexcept {
+        return !(lhs < rhs);
+    }
+
+private:
+    T* data_ = nullptr;
+    size_t stride_ = 1;
+    size_t index_ = 0;
+};
+
+//-------------------------SPAN---------------------
+template <typename T>
+constexpr StridedSpan<T> Span<T>::Strided(size_t stride) const noexcept {
+    assert(stride != 0);
+    return StridedSpan<T>(data_, (size_ + stride - 1) / stride, stride);
+}
+
+#if __cplusplus >= 202002L && __has_include(<ranges>)
+// Представления не владеют данными, и их итераторы переживают сам объект
+namespace std::ranges {
+template <typename T>
+inline constexpr bool enable_borrowed_range<Span<T>> = true;
+template <typename T>
+inline constexpr bool enable_borrowed_range<StridedSpan<T>> = true;
+}  // namespace std::ranges
+#endif
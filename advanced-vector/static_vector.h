@@ -0,0 +1,427 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+// Когда std::construct_at и std::destroy_at доступны в константных вычислениях (C++20),
+// StaticVector полностью constexpr и пригоден для построения таблиц при компиляции
+#if defined(__cpp_lib_constexpr_dynamic_alloc) && __cpp_lib_constexpr_dynamic_alloc >= 201907L
+#define STATIC_VECTOR_CONSTEXPR constexpr
+#define STATIC_VECTOR_HAS_CONSTEXPR 1
+#else
+#define STATIC_VECTOR_CONSTEXPR
+#define STATIC_VECTOR_HAS_CONSTEXPR 0
+#endif
+
+// Вектор ёмкостью не больше N элементов, хранящихся внутри объекта. Память никогда не
+// выделяется, а попытка добавить элемент сверх N бросает std::length_error.
+// Функции не используют побайтового копирования, поэтому работают и при вычислении
+// на этапе компиляции
+template <typename T, size_t N>
+class StaticVector {
+    static_assert(N > 0, "StaticVector needs a non-zero capacity");
+
+public:
+    using value_type = T;
+    using iterator = T*;
+    using const_iterator = const T*;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+
+    static constexpr size_t CAPACITY = N;
+
+    STATIC_VECTOR_CONSTEXPR StaticVector() noexcept = default;
+    STATIC_VECTOR_CONSTEXPR ~StaticVector();
+
+    STATIC_VECTOR_CONSTEXPR explicit StaticVector(size_t size);
+    STATIC_VECTOR_CONSTEXPR StaticVector(std::initializer_list<T> init_list);
+
+    STATIC_VECTOR_CONSTEXPR StaticVector(const StaticVector& other);
+    STATIC_VECTOR_CONSTEXPR StaticVector(StaticVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>);
+
+    STATIC_VECTOR_CONSTEXPR StaticVector& operator=(const StaticVector& rhs);
+    STATIC_VECTOR_CONSTEXPR StaticVector& operator=(StaticVector&& rhs) noexcept(std::is_nothrow_move_constructible_v<T>
+                                                                                && std::is_nothrow_move_assignable_v<T>);
+
+    STATIC_VECTOR_CONSTEXPR const T& operator[](size_t index) const noexcept;
+    STATIC_VECTOR_CONSTEXPR T& operator[](size_t index) noexcept;
+
+    STATIC_VECTOR_CONSTEXPR const T& At(size_t index) const;
+    STATIC_VECTOR_CONSTEXPR T& At(size_t index);
+
+    STATIC_VECTOR_CONSTEXPR const T& Front() const noexcept;
+    STATIC_VECTOR_CONSTEXPR T& Front() noexcept;
+    STATIC_VECTOR_CONSTEXPR const T& Back() const noexcept;
+    STATIC_VECTOR_CONSTEXPR T& Back() noexcept;
+
+    STATIC_VECTOR_CONSTEXPR iterator begin() noexcept;
+    STATIC_VECTOR_CONSTEXPR iterator end() noexcept;
+    STATIC_VECTOR_CONSTEXPR reverse_iterator rbegin() noexcept;
+    STATIC_VECTOR_CONSTEXPR reverse_iterator rend() noexcept;
+    STATIC_VECTOR_CONSTEXPR const_iterator begin() const noexcept;
+    STATIC_VECTOR_CONSTEXPR const_iterator end() const noexcept;
+    STATIC_VECTOR_CONSTEXPR const_iterator cbegin() const noexcept;
+    STATIC_VECTOR_CONSTEXPR const_iterator cend() const noexcept;
+
+    static constexpr size_t Capacity() noexcept;
+    STATIC_VECTOR_CONSTEXPR size_t Size() const noexcept;
+    STATIC_VECTOR_CONSTEXPR bool Empty() const noexcept;
+    STATIC_VECTOR_CONSTEXPR bool Full() const noexcept;
+
+    template <typename Value>
+    STATIC_VECTOR_CONSTEXPR void PushBack(Value&& value);
+
+    template <typename... Args>
+    STATIC_VECTOR_CONSTEXPR T& EmplaceBack(Args&&... args);
+
+    template <typename... Args>
+    STATIC_VECTOR_CONSTEXPR iterator Emplace(const_iterator pos, Args&&... args);
+
+    STATIC_VECTOR_CONSTEXPR iterator Insert(const_iterator pos, const T& value);
+    STATIC_VECTOR_CONSTEXPR iterator Insert(const_iterator pos, T&& value);
+
+    STATIC_VECTOR_CONSTEXPR void PopBack() noexcept;
+
+    STATIC_VECTOR_CONSTEXPR iterator Erase(const_iterator pos) noexcept(std::is_nothrow_move_assignable_v<T>);
+    STATIC_VECTOR_CONSTEXPR iterator Erase(const_iterator first, const_iterator last) noexcept(std::is_nothrow_move_assignable_v<T>);
+
+    STATIC_VECTOR_CONSTEXPR void Resize(size_t new_size);
+    STATIC_VECTOR_CONSTEXPR void Clear() noexcept;
+
+    STATIC_VECTOR_CONSTEXPR void Swap(StaticVector& other);
+
+private:
+    // Объединение не строит элементы массива: их время жизни начинается в ConstructAt
+    union Storage {
+        STATIC_VECTOR_CONSTEXPR Storage() noexcept {
+        }
+        STATIC_VECTOR_CONSTEXPR ~Storage() {
+        }
+
+        T data[N];
+    };
+
+    Storage storage_;
+    size_t size_ = 0;
+
+    template <typename... Args>
+    static STATIC_VECTOR_CONSTEXPR T* ConstructAt(T* dst, Args&&... args);
+
+    // Уничтожает элементы начиная с new_size
+    STATIC_VECTOR_CONSTEXPR void Truncate(size_t new_size) noexcept;
+
+    STATIC_VECTOR_CONSTEXPR void CheckCapacity(size_t required) const;
+};
+
+//-------------------------STATIC_VECTOR---------------------
+template <typename T, size_t N>
+inline STATIC_VECTOR_CONSTEXPR StaticVector<T, N>::~StaticVector() {
+    Truncate(0);
+}
+
+// Делегирующие конструкторы: после StaticVector() объект считается построенным,
+// и при исключении деструктор уничтожит уже добавленные элементы
+template <typename T, size_t N>
+inline STATIC_VECTOR_CONSTEXPR StaticVector<T, N>::StaticVector(size_t size) : StaticVector() {
+    Resize(size);
+}
+
+template <typename T, size_t N>
+inline STATIC_VECTOR_CONSTEXPR StaticVector<T, N>::StaticVector(std::initializer_list<T> init_list) : StaticVector() {
+    CheckCapacity(init_list.size());
+    for (const T& value : init_list) {
+        EmplaceBack(value);
+    }
+}
+
+template <typename T, size_t N>
+inline STATIC_VECTOR_CONSTEXPR StaticVector<T, N>::StaticVector(const StaticVector& other) : StaticVector() {
+    for (const T& value : other) {
+        EmplaceBack(value);
+    }
+}
+
+template <typename T, size_t N>
+inline STATIC_VECTOR_CONSTEXPR StaticVector<T, N>::StaticVector(StaticVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+    : StaticVector() {
+    for (T& value : other) {
+        EmplaceBack(std::move(value));
+    }
+}
+
+template <typename T, size_t N>
+inline STATIC_VECTOR_CONSTEXPR StaticVector<T, N>& StaticVector<T, N>::operator=(const StaticVector& rhs) {
+    if (this != &rhs) {
+        const size_t common = std::min(size_, rhs.size_);
+        std::copy(rhs.begin(), rhs.begin() + common, begin());
+        if (rhs.size_ < size_) {
+            Truncate(rhs.size_);
+        } else {
+            for (size_t i = common; i < rhs.size_; ++i) {
+                EmplaceBack(rhs[i]);
+            }
+        }
+    }
+    return *this;
+}
+
+template <typename T, size_t N>
+inline STATIC_VECTOR_CONSTEXPR StaticVector<T, N>& StaticVector<T, N>::operator=(StaticVector&& rhs) noexcept(
+    std::is_nothrow_move_constructible_v<T> && std::is_nothrow_move_assignable_v<T>) {
+    if (this != &rhs) {
+        const size_t common = std::min(size_, rhs.size_);
+        std::move(rhs.begin(), rhs.begin() + common, begin());
+        if (rhs.size_ < size_) {
+            Truncate(rhs.size_);
+        } else {
+            for (size_t i = common; i < rhs.size_; ++i) {
+                EmplaceBack(std::move(rhs[i]));
+            }
+        }
+    }
+    return *this;
+}
+
+template <typename T, size_t N>
+inline STATIC_VECTOR_CONSTEXPR const T& StaticVector<T, N>::operator[](size_t index) const noexcept {
+    assert(index < size_);
+    return storage_.data[index];
+}
+
+template <typename T, size_t N>
+inline STATIC_VECTOR_CONSTEXPR T& StaticVector<T, N>::operator[](size_t index) noexcept {
+    assert(index < size_);
+    return storage_.data[index];
+}
+
+template <typename T, size_t N>
+inline STATIC_VECTOR_CONSTEXPR const T& StaticVector<T, N>::At(size_t index) const {
+    if (index >= size_) {
+        throw std::out_of_range("Index out of range");
+    }
+    return storage_.data[index];
+}
+
+template <typename T, size_t N>
+inline STATIC_VECTOR_CONSTEXPR T& StaticVector<T, N>::At(size_t index) {
+    if (index >= size_) {
+        throw std::out_of_range("Index out of range");
+    }
+    return storage_.data[index];
+}
+
+template <typename T, size_t N>
+inline STATIC_VECTOR_CONSTEXPR const T& StaticVector<T, N>::Front() const noexcept {
+    return (*this)[0];
+}
+
+template <typename T, size_t N>
+inline STATIC_VECTOR_CONSTEXPR T& StaticVector<T, N>::Front() noexcept {
+    return (*this)[0];
+}
+
+template <typename T, size_t N>
+inline STATIC_VECTOR_CONSTEXPR const T& StaticVector<T, N>::Back() const noexcept {
+    return (*this)[size_ - 1];
+}
+
+template <typename T, size_t N>
+inline STATIC_VECTOR_CONSTEXPR T& StaticVector<T, N>::Back() noexcept {
+    return (*this)[size_ - 1];
+}
+
+template <typename T, size_t N>
+inline STATIC_VECTOR_CONSTEXPR typename StaticVector<T, N>::iterator StaticVector<T, N>::begin() noexcept {
+    return storage_.data;
+}
+
+template <typename T, size_t N>
+inline STATIC_VECTOR_CONSTEXPR typename StaticVector<T, N>::iterator StaticVector<T, N>::end() noexcept {
+    return storage_.data + size_;
+}
+
+template <typename T, size_t N>
+inline STATIC_VECTOR_CONSTEXPR typename StaticVector<T, N>::reverse_iterator StaticVector<T, N>::rbegin() noexcept {
+    return reverse_iterator(end());
+}
+
+template <typename T, size_t N>
+inline STATIC_VECTOR_CONSTEXPR typename StaticVector<T, N>::reverse_iterator StaticVector<T, N>::rend() noexcept {
+    return reverse_iterator(begin());
+}
+
+template <typename T, size_t N>
+inline STATIC_VECTOR_CONSTEXPR typename StaticVector<T, N>::const_iterator StaticVector<T, N>::begin() const noexcept {
+    return storage_.data;
+}
+
+template <typename T, size_t N>
+inline STATIC_VECTOR_CONSTEXPR typename StaticVector<T, N>::const_iterator StaticVector<T, N>::end() const noexcept {
+    return storage_.data + size_;
+}
+
+template <typename T, size_t N>
+inline STATIC_VECTOR_CONSTEXPR typename StaticVector<T, N>::const_iterator StaticVector<T, N>::cbegin() const noexcept {
+    return begin();
+}
+
+template <typename T, size_t N>
+inline STATIC_VECTOR_CONSTEXPR typename StaticVector<T, N>::const_iterator StaticVector<T, N>::cend() const noexcept {
+    return end();
+}
+
+template <typename T, size_t N>
+inline constexpr size_t StaticVector<T, N>::Capacity() noexcept {
+    return N;
+}
+
+template <typename T, size_t N>
+inline STATIC_VECTOR_CONSTEXPR size_t StaticVector<T, N>::Size() const noexcept {
+    return size_;
+}
+
+template <typename T, size_t N>
+inline STATIC_VECTOR_CONSTEXPR bool StaticVector<T, N>::Empty() const noexcept {
+    return size_ == 0;
+}
+
+template <typename T, size_t N>
+inline STATIC_VECTOR_CONSTEXPR bool StaticVector<T, N>::Full() const noexcept {
+    return size_ == N;
+}
+
+template <typename T, size_t N>
+template <typename Value>
+inline STATIC_VECTOR_CONSTEXPR void StaticVector<T, N>::PushBack(Value&& value) {
+    EmplaceBack(std::forward<Value>(value));
+}
+
+template <typename T, size_t N>
+template <typename... Args>
+inline STATIC_VECTOR_CONSTEXPR T& StaticVector<T, N>::EmplaceBack(Args&&... args) {
+    CheckCapacity(size_ + 1);
+    T* element = ConstructAt(end(), std::forward<Args>(args)...);
+    ++size_;
+    return *element;
+}
+
+template <typename T, size_t N>
+template <typename... Args>
+inline STATIC_VECTOR_CONSTEXPR typename StaticVector<T, N>::iterator StaticVector<T, N>::Emplace(const_iterator pos, Args&&... args) {
+    assert(pos >= begin() && pos <= end());
+
+    const size_t index = static_cast<size_t>(pos - begin());
+    if (index == size_) {
+        EmplaceBack(std::forward<Args>(args)...);
+        return begin() + index;
+    }
+
+    CheckCapacity(size_ + 1);
+    // Аргумент может ссылаться на элемент вектора, поэтому значение строится до сдвига
+    T value(std::forward<Args>(args)...);
+    ConstructAt(end(), std::move(Back()));
+    ++size_;
+    std::move_backward(begin() + index, end() - 2, end() - 1);
+    storage_.data[index] = std::move(value);
+    return begin() + index;
+}
+
+template <typename T, size_t N>
+inline STATIC_VECTOR_CONSTEXPR typename StaticVector<T, N>::iterator StaticVector<T, N>::Insert(const_iterator pos, const T& value) {
+    return Emplace(pos, value);
+}
+
+template <typename T, size_t N>
+inline STATIC_VECTOR_CONSTEXPR typename StaticVector<T, N>::iterator StaticVector<T, N>::Insert(const_iterator pos, T&& value) {
+    return Emplace(pos, std::move(value));
+}
+
+template <typename T, size_t N>
+inline STATIC_VECTOR_CONSTEXPR void StaticVector<T, N>::PopBack() noexcept {
+    assert(size_ != 0);
+    Truncate(size_ - 1);
+}
+
+template <typename T, size_t N>
+inline STATIC_VECTOR_CONSTEXPR typename StaticVector<T, N>::iterator StaticVector<T, N>::Erase(const_iterator pos) noexcept(
+    std::is_nothrow_move_assignable_v<T>) {
+    return Erase(pos, pos + 1);
+}
+
+template <typename T, size_t N>
+inline STATIC_VECTOR_CONSTEXPR typename StaticVector<T, N>::iterator StaticVector<T, N>::Erase(
+    const_iterator first, const_iterator last) noexcept(std::is_nothrow_move_assignable_v<T>) {
+    assert(begin() <= first && first <= last && last <= end());
+
+    const size_t index = static_cast<size_t>(first - begin());
+    const size_t count = static_cast<size_t>(last - first);
+    std::move(begin() + index + count, end(), begin() + index);
+    Truncate(size_ - count);
+    return begin() + index;
+}
+
+template <typename T, size_t N>
+inline STATIC_VECTOR_CONSTEXPR void StaticVector<T, N>::Resize(size_t new_size) {
+    CheckCapacity(new_size);
+    Truncate(std::min(new_size, size_));
+    while (size_ < new_size) {
+        EmplaceBack();
+    }
+}
+
+template <typename T, size_t N>
+inline STATIC_VECTOR_CONSTEXPR void StaticVector<T, N>::Clear() noexcept {
+    Truncate(0);
+}
+
+template <typename T, size_t N>
+inline STATIC_VECTOR_CONSTEXPR void StaticVector<T, N>::Swap(StaticVector& other) {
+    StaticVector& longer = size_ >= other.size_ ? *this : other;
+    StaticVector& shorter = size_ >= other.size_ ? other : *this;
+
+    const size_t common = shorter.size_;
+    for (size_t i = 0; i < common; ++i) {
+        using std::swap;
+        swap(storage_.data[i], other.storage_.data[i]);
+    }
+    for (size_t i = common; i < longer.size_; ++i) {
+        shorter.EmplaceBack(std::move(longer.storage_.data[i]));
+    }
+    longer.Truncate(common);
+}
+
+template <typename T, size_t N>
+template <typename... Args>
+inline STATIC_VECTOR_CONSTEXPR T* StaticVector<T, N>::ConstructAt(T* dst, Args&&... args) {
+#if STATIC_VECTOR_HAS_CONSTEXPR
+    return std::construct_at(dst, std::forward<Args>(args)...);
+#else
+    return new (dst) T(std::forward<Args>(args)...);
+#endif
+}
+
+template <typename T, size_t N>
+inline STATIC_VECTOR_CONSTEXPR void StaticVector<T, N>::Truncate(size_t new_size) noexcept {
+    // Уничтожение с конца, как в деструкторе массива
+    while (size_ > new_size) {
+        --size_;
+        std::destroy_at(storage_.data + size_);
+    }
+}
+
+template <typename T, size_t N>
+inline STATIC_VECTOR_CONSTEXPR void StaticVector<T, N>::CheckCapacity(size_t required) const {
+    if (required > N) {
+        throw std::length_error("StaticVector capacity exceeded");
+    }
+}
+
+#undef STATIC_VECTOR_CONSTEXPR
+#undef STATIC_VECTOR_HAS_CONSTEXPR
@@ -0,0 +1,300 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+
+// Пул потоков с перехватом задач. У каждого рабочего потока своя очередь: задачи,
+// поставленные из рабочего потока, попадают в его очередь и выполняются им в порядке LIFO,
+// а освободившиеся потоки забирают самые старые задачи из чужих очередей.
+// Поток, ожидающий группу задач, сам выполняет задачи пула, поэтому вложенные
+// группы не блокируют пул
+class ThreadPool {
+public:
+    using Task = std::function<void()>;
+
+    // 0 - std::thread::hardware_concurrency()
+    explicit ThreadPool(size_t threads = 0);
+    // Дожидается выполнения поставленных задач
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Задача не должна бросать исключений; для задач с исключениями служит TaskGroup
+    void Submit(Task task);
+
+    // Выполняет одну задачу пула в вызывающем потоке. Возвращает false, если задач нет
+    bool RunPendingTask();
+
+    // Усыпляет вызывающий поток, пока в пуле нет задач и done() ложно. Тот, кто делает
+    // done() истинным, должен затем вызвать NotifyWaiters
+    template <typename Predicate>
+    void WaitForTask(Predicate done);
+    void NotifyWaiters() noexcept;
+
+    size_t ThreadCount() const noexcept;
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::unique_ptr<Queue[]> queues_;
+    std::unique_ptr<std::thread[]> workers_;
+    size_t thread_count_ = 0;
+
+    std::atomic<size_t> queued_{0};
+    std::atomic<size_t> next_queue_{0};
+    std::mutex sleep_mutex_;
+    std::condition_variable wake_;
+    bool stop_ = false;
+
+    // Пул и очередь рабочего потока, в котором выполняется код
+    static inline thread_local ThreadPool* current_pool_ = nullptr;
+    static inline thread_local size_t current_queue_ = 0;
+
+    void WorkerLoop(size_t index);
+    void Stop() noexcept;
+    // Берёт задачу из своей очереди с конца или из чужих очередей с начала
+    bool TryPop(size_t home, bool own, Task& task);
+};
+
+// Пул, общий для параллельных алгоритмов, с числом потоков по числу ядер
+ThreadPool& DefaultThreadPool();
+
+// Группа задач с общим ожиданием. Первое исключение, брошенное задачей, сохраняется
+// и пробрасывается из Wait после завершения остальных задач группы
+class TaskGroup {
+public:
+    explicit TaskGroup(ThreadPool& pool = DefaultThreadPool()) noexcept;
+    // Дожидается задач, не пробрасывая исключений
+    ~TaskGroup();
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    // Захваты function уничтожаются до того, как задача считается завершённой
+    template <typename Function>
+    void Run(Function&& function);
+
+    // Выполняет задачи пула, пока не завершатся задачи группы
+    void Wait();
+
+private:
+    ThreadPool& pool_;
+    std::atomic<size_t> pending_{0};
+    std::mutex error_mutex_;
+    std::exception_ptr error_;
+
+    void WaitPending() noexcept;
+};
+
+//-------------------------THREAD_POOL---------------------
+inline ThreadPool::ThreadPool(size_t threads) {
+    thread_count_ = threads != 0 ? threads : std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    queues_ = std::make_unique<Queue[]>(thread_count_);
+    workers_ = std::make_unique<std::thread[]>(thread_count_);
+
+    try {
+        for (size_t i = 0; i < thread_count_; ++i) {
+            workers_[i] = std::thread(&ThreadPool::WorkerLoop, this, i);
+        }
+    } catch (...) {
+        Stop();
+        throw;
+    }
+}
+
+inline ThreadPool::~ThreadPool() {
+    Stop();
+}
+
+inline void ThreadPool::Submit(Task task) {
+    const size_t index = current_pool_ == this ? current_queue_
+                                               : next_queue_.fetch_add(1, std::memory_order_relaxed) % thread_count_;
+    {
+        std::lock_guard lock(queues_[index].mutex);
+        queues_[index].tasks.push_back(std::move(task));
+    }
+    queued_.fetch_add(1, std::memory_order_release);
+
+    // Захват мьютекса не даёт потоку уснуть между проверкой счётчика и ожиданием
+    {
+        std::lock_guard lock(sleep_mutex_);
+    }
+    wake_.notify_one();
+}
+
+inline bool ThreadPool::RunPendingTask() {
+    Task task;
+    const bool own = current_pool_ == this;
+    if (!TryPop(own ? current_queue_ : 0, own, task)) {
+        return false;
+    }
+    task();
+    return true;
+}
+
+template <typename Predicate>
+inline void ThreadPool::WaitForTask(Predicate done) {
+    std::unique_lock lock(sleep_mutex_);
+    wake_.wait(lock, [this, &done] {
+        return done() || queued_.load(std::memory_order_acquire) != 0;
+    });
+    // Если пробуждение от Submit досталось потоку, которому задача уже не нужна, его
+    // передают дальше, иначе задача может ждать, пока спят все остальные
+    if (done() && queued_.load(std::memory_order_acquire) != 0) {
+        wake_.notify_one();
+    }
+}
+
+inline void ThreadPool::NotifyWaiters() noexcept {
+    // Захват мьютекса не даёт ожидающему уснуть между проверкой условия и ожиданием
+    {
+        std::lock_guard lock(sleep_mutex_);
+    }
+    wake_.notify_all();
+}
+
+inline size_t ThreadPool::ThreadCount() const noexcept {
+    return thread_count_;
+}
+
+inline void ThreadPool::WorkerLoop(size_t index) {
+    current_pool_ = this;
+    current_queue_ = index;
+
+    Task task;
+    while (true) {
+        if (TryPop(index, true, task)) {
+            task();
+            task = nullptr;
+            continue;
+        }
+
+        std::unique_lock lock(sleep_mutex_);
+        wake_.wait(lock, [this] {
+            return stop_ || queued_.load(std::memory_order_acquire) != 0;
+        });
+        if (stop_ && queued_.load(std::memory_order_acquire) == 0) {
+            return;
+        }
+    }
+}
+
+inline void ThreadPool::Stop() noexcept {
+    {
+        std::lock_guard lock(sleep_mutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+
+    for (size_t i = 0; i < thread_count_; ++i) {
+        if (workers_[i].joinable()) {
+            workers_[i].join();
+        }
+    }
+}
+
+inline bool ThreadPool::TryPop(size_t home, bool own, Task& task) {
+    if (queued_.load(std::memory_order_acquire) == 0) {
+        return false;
+    }
+
+    for (size_t i = 0; i < thread_count_; ++i) {
+        Queue& queue = queues_[(home + i) % thread_count_];
+        std::lock_guard lock(queue.mutex);
+        if (queue.tasks.empty()) {
+            continue;
+        }
+
+        if (own && i == 0) {
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+        } else {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+        }
+        queued_.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+
+inline ThreadPool& DefaultThreadPool() {
+    static ThreadPool pool;
+    return pool;
+}
+
+//-------------------------TASK_GROUP---------------------
+inline TaskGroup::TaskGroup(ThreadPool& pool) noexcept : pool_(pool) {
+}
+
+inline TaskGroup::~TaskGroup() {
+    WaitPending();
+}
+
+template <typename Function>
+inline void TaskGroup::Run(Function&& function) {
+    pending_.fetch_add(1, std::memory_order_relaxed);
+    try {
+        pool_.Submit([this, function = std::optional<std::decay_t<Function>>(std::in_place, std::forward<Function>(function))]() mutable noexcept {
+            try {
+                (*function)();
+            } catch (...) {
+                std::lock_guard lock(error_mutex_);
+                if (error_ == nullptr) {
+                    error_ = std::current_exception();
+                }
+            }
+            // Захваты уничтожаются до уменьшения счётчика: после него Wait может вернуться,
+            // а сама обёртка живёт в очереди пула дольше
+            function.reset();
+            // После последнего уменьшения группа может быть уже уничтожена, поэтому пул
+            // запоминается заранее
+            ThreadPool& pool = pool_;
+            if (pending_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                pool.NotifyWaiters();
+            }
+        });
+    } catch (...) {
+        pending_.fetch_sub(1, std::memory_order_relaxed);
+        throw;
+    }
+}
+
+inline void TaskGroup::Wait() {
+    WaitPending();
+
+    std::exception_ptr error;
+    {
+        std::lock_guard lock(error_mutex_);
+        std::swap(error, error_);
+    }
+    if (error != nullptr) {
+        std::rethrow_exception(error);
+    }
+}
+
+inline void TaskGroup::WaitPending() noexcept {
+    const auto done = [this] {
+        return pending_.load(std::memory_order_acquire) == 0;
+    };
+    while (!done()) {
+        if (!pool_.RunPendingTask()) {
+            // Задачи группы выполняются другими потоками: ждём их завершения или новой задачи
+            pool_.WaitForTask(done);
+        }
+    }
+}
@@ -0,0 +1,149 @@
+#pragma once
+
+#include "allocators.h"
+#include "span.h"
+#include "vector.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+// Обход элементов с программной предвыборкой. Последовательное чтение самого буфера
+// аппаратная предвыборка распознаёт сама; помогать нужно косвенным обращениям, например
+// к объектам под указателями в Vector<Node*> или Vector<std::unique_ptr<T>>.
+// На компиляторах без __builtin_prefetch обход выполняется без подсказок
+
+// Размеры блоков для ForEachChunk: типичные L1d и L2 одного ядра
+inline constexpr size_t L1_BLOCK_BYTES = 32 * 1024;
+inline constexpr size_t L2_BLOCK_BYTES = 256 * 1024;
+
+// Адрес, который нужно загрузить заранее для элемента: объект под сырым или умным
+// указателем, для остальных типов - сам элемент
+struct PrefetchAddress {
+    template <typename T>
+    const void* operator()(const T& value) const noexcept;
+};
+
+// Вызывает fn(element) для элементов по порядку и заранее запрашивает в кэш
+// address_of(элемент на distance позиций впереди). distance == 0 отключает предвыборку
+template <typename T, typename Function, typename AddressOf = PrefetchAddress>
+void ForEachPrefetched(Span<T> elements, size_t distance, Function fn, AddressOf address_of = AddressOf());
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy, typename Function,
+          typename AddressOf = PrefetchAddress>
+void ForEachPrefetched(Vector<T, Allocator, GrowthPolicy, StatsPolicy>& v, size_t distance, Function fn,
+                       AddressOf address_of = AddressOf());
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy, typename Function,
+          typename AddressOf = PrefetchAddress>
+void ForEachPrefetched(const Vector<T, Allocator, GrowthPolicy, StatsPolicy>& v, size_t distance, Function fn,
+                       AddressOf address_of = AddressOf());
+
+// Передаёт fn(Span) подряд идущие блоки по chunk_bytes байт, но не меньше одного элемента;
+// последний блок может быть короче. Перед обработкой блока запрашивается начало следующего
+template <typename T, typename Function>
+void ForEachChunk(Span<T> elements, size_t chunk_bytes, Function fn);
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy, typename Function>
+void ForEachChunk(Vector<T, Allocator, GrowthPolicy, StatsPolicy>& v, size_t chunk_bytes, Function fn);
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy, typename Function>
+void ForEachChunk(const Vector<T, Allocator, GrowthPolicy, StatsPolicy>& v, size_t chunk_bytes, Function fn);
+
+namespace traversal_detail {
+
+// Строк кэша следующего блока, запрашиваемых заранее: дальше поток подхватывает аппаратная предвыборка
+inline constexpr size_t CHUNK_PREFETCH_LINES = 8;
+
+template <typename T, typename = void>
+struct HasGet : std::false_type {};
+
+template <typename T>
+struct HasGet<T, std::void_t<decltype(std::declval<const T&>().get())>>
+    : std::is_pointer<decltype(std::declval<const T&>().get())> {};
+
+inline void Prefetch([[maybe_unused]] const void* address) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(address, 0, 3);
+#endif
+}
+
+}  // namespace traversal_detail
+
+//-------------------------PREFETCH_ADDRESS---------------------
+template <typename T>
+inline const void* PrefetchAddress::operator()(const T& value) const noexcept {
+    if constexpr (std::is_pointer_v<T> && std::is_object_v<std::remove_pointer_t<T>>) {
+        return value;
+    } else if constexpr (traversal_detail::HasGet<T>::value) {
+        return value.get();
+    } else {
+        return std::addressof(value);
+    }
+}
+
+//-------------------------FOR_EACH_PREFETCHED---------------------
+template <typename T, typename Function, typename AddressOf>
+inline void ForEachPrefetched(Span<T> elements, size_t distance, Function fn, AddressOf address_of) {
+    T* const data = elements.Data();
+    const size_t size = elements.Size();
+    const size_t ahead = std::min(distance, size);
+
+    // Первые ahead элементов запрашиваются сразу, затем окно сдвигается вместе с курсором
+    for (size_t i = 0; i < ahead; ++i) {
+        traversal_detail::Prefetch(address_of(data[i]));
+    }
+
+    size_t i = 0;
+    for (; i + ahead < size; ++i) {
+        traversal_detail::Prefetch(address_of(data[i + ahead]));
+        fn(data[i]);
+    }
+    for (; i < size; ++i) {
+        fn(data[i]);
+    }
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy, typename Function, typename AddressOf>
+inline void ForEachPrefetched(Vector<T, Allocator, GrowthPolicy, StatsPolicy>& v, size_t distance, Function fn,
+                              AddressOf address_of) {
+    ForEachPrefetched(v.AsSpan(), distance, std::move(fn), std::move(address_of));
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy, typename Function, typename AddressOf>
+inline void ForEachPrefetched(const Vector<T, Allocator, GrowthPolicy, StatsPolicy>& v, size_t distance, Function fn,
+                              AddressOf address_of) {
+    ForEachPrefetched(v.AsSpan(), distance, std::move(fn), std::move(address_of));
+}
+
+//-------------------------FOR_EACH_CHUNK---------------------
+template <typename T, typename Function>
+inline void ForEachChunk(Span<T> elements, size_t chunk_bytes, Function fn) {
+    const size_t size = elements.Size();
+    const size_t chunk = std::max<size_t>(chunk_bytes / sizeof(T), 1);
+    const size_t prefetch_bytes = std::min(chunk * sizeof(T), traversal_detail::CHUNK_PREFETCH_LINES * CACHE_LINE_SIZE);
+
+    for (size_t offset = 0; offset < size; offset += chunk) {
+        const size_t count = std::min(chunk, size - offset);
+        if (offset + count < size) {
+            const char* next = reinterpret_cast<const char*>(elements.Data() + offset + count);
+            const size_t next_bytes = std::min(prefetch_bytes, (size - offset - count) * sizeof(T));
+            for (size_t line = 0; line < next_bytes; line += CACHE_LINE_SIZE) {
+                traversal_detail::Prefetch(next + line);
+            }
+        }
+        fn(elements.Subspan(offset, count));
+    }
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy, typename Function>
+inline void ForEachChunk(Vector<T, Allocator, GrowthPolicy, StatsPolicy>& v, size_t chunk_bytes, Function fn) {
+    ForEachChunk(v.AsSpan(), chunk_bytes, std::move(fn));
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy, typename Function>
+inline void ForEachChunk(const Vector<T, Allocator, GrowthPolicy, StatsPolicy>& v, size_t chunk_bytes, Function fn) {
+    ForEachChunk(v.AsSpan(), chunk_bytes, std::move(fn));
+}
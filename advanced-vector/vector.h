@@ -2,18 +2,159 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstddef>
 #include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iterator>
 #include <memory>
 #include <new>
 #include <stdexcept>
 #include <type_traits>
 #include <utility>
 
+#include "checked_iterator.h"
+#include "growth_policy.h"
+#include "parallel.h"
+#include "span.h"
+#include "vector_stats.h"
+
+// Проверка предусловия: в проверяемом режиме действует в любой сборке, иначе это assert
+#ifdef ADVANCED_VECTOR_CHECKED
+#define VECTOR_CHECK(condition, message) ((condition) ? void(0) : checked_detail::Fail(message))
+#else
+#define VECTOR_CHECK(condition, message) assert(condition)
+#endif
+
+// Объекты типа T можно перенести в другую область памяти побайтовым копированием,
+// не вызывая конструктор перемещения и деструктор исходного объекта.
+// Для собственных типов (например, владеющих дескрипторов) допускается специализация
 template <typename T>
+struct IsTriviallyRelocatable : std::is_trivially_copyable<T> {};
+
+// Переносит n объектов из src в неинициализированную память dst, области могут перекрываться.
+// После переноса объекты по адресу src считаются уничтоженными
+template <typename T>
+inline void RelocateN(T* src, size_t n, T* dst) noexcept {
+    static_assert(IsTriviallyRelocatable<T>::value);
+
+    if (n != 0) {
+        std::memmove(static_cast<void*>(dst), static_cast<const void*>(src), n * sizeof(T));
+    }
+}
+
+template <typename Iter>
+using IteratorCategory = typename std::iterator_traits<Iter>::iterator_category;
+
+template <typename Iter, typename = void>
+struct IsInputIterator : std::false_type {};
+
+template <typename Iter>
+struct IsInputIterator<Iter, std::void_t<IteratorCategory<Iter>>>
+    : std::is_convertible<IteratorCategory<Iter>, std::input_iterator_tag> {};
+
+template <typename Iter, typename = void>
+struct IsForwardIterator : std::false_type {};
+
+template <typename Iter>
+struct IsForwardIterator<Iter, std::void_t<IteratorCategory<Iter>>>
+    : std::is_convertible<IteratorCategory<Iter>, std::forward_iterator_tag> {};
+
+// Прямой итератор, повторяющий одно и то же значение: позволяет вставку n копий
+// выразить через вставку диапазона
+template <typename T>
+class RepeatIterator {
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const T*;
+    using reference = const T&;
+
+    explicit RepeatIterator(const T& value, size_t index = 0) noexcept : value_(&value), index_(index) {
+    }
+
+    reference operator*() const noexcept {
+        return *value_;
+    }
+
+    pointer operator->() const noexcept {
+        return value_;
+    }
+
+    RepeatIterator& operator++() noexcept {
+        ++index_;
+        return *this;
+    }
+
+    RepeatIterator operator++(int) noexcept {
+        RepeatIterator old = *this;
+        ++index_;
+        return old;
+    }
+
+    bool operator==(const RepeatIterator& other) const noexcept {
+        return index_ == other.index_;
+    }
+
+    bool operator!=(const RepeatIterator& other) const noexcept {
+        return index_ != other.index_;
+    }
+
+private:
+    const T* value_;
+    size_t index_;
+};
+
+// Тег конструирования элементов инициализацией по умолчанию: для тривиальных типов
+// память остаётся неинициализированной и не заполняется нулями
+struct DefaultInitTag {
+    explicit DefaultInitTag() = default;
+};
+
+inline constexpr DefaultInitTag DEFAULT_INIT{};
+
+// Буфер, переданный вектором внешнему коду: size построенных элементов в памяти на
+// capacity элементов. Память освобождается аллокатором вектора: deallocate(data, capacity)
+template <typename T>
+struct VectorBuffer {
+    T* data = nullptr;
+    size_t size = 0;
+    size_t capacity = 0;
+};
+
+// Аллокатор умеет изменять размер выделенного буфера на месте: a.reallocate(buf, old_n, new_n)
+template <typename Allocator, typename = void>
+struct HasReallocate : std::false_type {};
+
+template <typename Allocator>
+struct HasReallocate<Allocator, std::void_t<decltype(std::declval<Allocator&>().reallocate(
+    std::declval<typename std::allocator_traits<Allocator>::pointer>(), size_t{}, size_t{}))>> : std::true_type {};
+
+// Аллокатор сообщает реальный размер выделенного блока: a.usable_size(buf, n) >= n элементов
+template <typename Allocator, typename = void>
+struct HasUsableSize : std::false_type {};
+
+template <typename Allocator>
+struct HasUsableSize<Allocator, std::void_t<decltype(std::declval<const Allocator&>().usable_size(
+    std::declval<typename std::allocator_traits<Allocator>::pointer>(), size_t{}))>> : std::true_type {};
+
+// StatsPolicy с учётом памяти получает события о выделении и освобождении буфера
+template <typename T, typename Allocator = std::allocator<T>, typename StatsPolicy = NoVectorStats>
 class RawMemory {
+    using AllocTraits = std::allocator_traits<Allocator>;
+
+    static_assert(std::is_same_v<typename AllocTraits::value_type, T>,
+                  "Allocator::value_type must be the same as T");
+    static_assert(std::is_same_v<typename AllocTraits::pointer, T*>,
+                  "Fancy pointers are not supported");
+
 public:
+    using allocator_type = Allocator;
+
     RawMemory() = default;
-    explicit RawMemory(size_t capacity);
+    explicit RawMemory(const Allocator& alloc) noexcept;
+    explicit RawMemory(size_t capacity, const Allocator& alloc = Allocator());
 
     ~RawMemory();
 
@@ -21,6 +162,8 @@ public:
     RawMemory& operator=(const RawMemory& rhs) = delete;
 
     RawMemory(RawMemory&& other) noexcept;
+    // Аллокатор перемещается только при propagate_on_container_move_assignment,
+    // иначе аллокаторы обязаны быть равны
     RawMemory& operator=(RawMemory&& rhs) noexcept;
 
     T* operator+(size_t offset) noexcept;
@@ -29,53 +172,109 @@ public:
     const T& operator[](size_t index) const noexcept;
     T& operator[](size_t index) noexcept;
 
+    // Аллокаторы обмениваются только при propagate_on_container_swap
     void Swap(RawMemory& other) noexcept;
 
+    // Освобождает буфер и заменяет аллокатор копией alloc
+    void Reset(const Allocator& alloc) noexcept;
+
+    // Отдаёт буфер вызывающему коду, после чего RawMemory пуста
+    T* Release() noexcept;
+
+    // Освобождает текущий буфер и принимает buf ёмкостью capacity, выделенный тем же аллокатором
+    void Adopt(T* buf, size_t capacity) noexcept;
+
+    // Расширяет буфер на месте средствами аллокатора, побайтово сохраняя содержимое.
+    // Допустимо только для тривиально перемещаемых T и аллокаторов с reallocate
+    void Reallocate(size_t new_capacity);
+
     const T* GetAddress() const noexcept;
     T* GetAddress() noexcept;
 
     size_t Capacity() const;
 
+    const Allocator& GetAllocator() const noexcept;
+
 private:
     T* buffer_ = nullptr;
     size_t capacity_ = 0;
+    Allocator alloc_;
 
     // Выделяет сырую память под n элементов и возвращает указатель на неё
-    static T* Allocate(size_t n);
+    T* Allocate(size_t n);
 
-    // Освобождает сырую память, выделенную ранее по адресу buf при помощи Allocate
-    static void Deallocate(T* buf) noexcept;
+    // Ёмкость буфера buf, запрошенного под n элементов, с учётом запаса, выделенного аллокатором
+    size_t UsableCapacity(T* buf, size_t n) const noexcept;
+
+    // Освобождает сырую память под n элементов, выделенную ранее по адресу buf при помощи Allocate
+    void Deallocate(T* buf, size_t n) noexcept;
+
+    // Сообщают StatsPolicy с учётом памяти, что буфер ёмкостью capacity появился или исчез
+    static void AccountAcquire(size_t capacity) noexcept;
+    static void AccountRelease(size_t capacity) noexcept;
 };
 
-template <typename T>
+// Vector не используется в константных вычислениях: перенос элементов через memmove,
+// расширения аллокатора (reallocate, usable_size), политики статистики и проверяемый режим
+// не работают при компиляции. Таблицы, построенные на этапе компиляции, хранит StaticVector
+template <typename T, typename Allocator = std::allocator<T>, typename GrowthPolicy = DoublingGrowth,
+          typename StatsPolicy = NoVectorStats>
 class Vector {
+    using AllocTraits = std::allocator_traits<Allocator>;
+
 public:
+    using value_type = T;
+    using allocator_type = Allocator;
+
     Vector() = default;
     ~Vector();
 
-    explicit Vector(size_t size);
-    explicit Vector(std::initializer_list<T> init_list);
+    explicit Vector(const Allocator& alloc) noexcept;
+    explicit Vector(size_t size, const Allocator& alloc = Allocator());
+    Vector(size_t size, DefaultInitTag, const Allocator& alloc = Allocator());
+    explicit Vector(std::initializer_list<T> init_list, const Allocator& alloc = Allocator());
+
+    template <typename InIter, typename = std::enable_if_t<IsInputIterator<InIter>::value>>
+    Vector(InIter first, InIter last, const Allocator& alloc = Allocator());
 
     Vector(const Vector& other); 
-    Vector(Vector&& other);
+    Vector(const Vector& other, const Allocator& alloc); 
+    Vector(Vector&& other) noexcept;
+
+    // Параллельные варианты конструирования для больших векторов. При исключении
+    // уже построенные элементы уничтожаются во всех потоках
+    Vector(ParallelTag policy, size_t size, const Allocator& alloc = Allocator());
+    Vector(ParallelTag policy, const Vector& other);
 
     Vector& operator=(const Vector& other);
-    Vector& operator=(Vector&& other);
+    Vector& operator=(Vector&& other) noexcept(AllocTraits::propagate_on_container_move_assignment::value
+                                               || AllocTraits::is_always_equal::value);
 
-    const T& operator[](size_t index) const noexcept;
-    T& operator[](size_t index) noexcept;
+    // Без ADVANCED_VECTOR_CHECKED индекс проверяется только assert
+    const T& operator[](size_t index) const noexcept(!CHECKED_MODE);
+    T& operator[](size_t index) noexcept(!CHECKED_MODE);
+
+    // Бросает std::out_of_range, если index >= Size()
+    const T& At(size_t index) const;
+    T& At(size_t index);
 
-    const T& At(size_t index) const noexcept;
-    T& At(size_t index) noexcept;
+    const T& Front() const noexcept(!CHECKED_MODE);
+    T& Front() noexcept(!CHECKED_MODE);
 
-    const T& Front() const noexcept;
-    T& Front() noexcept;
+    const T& Back() const noexcept(!CHECKED_MODE);
+    T& Back() noexcept(!CHECKED_MODE);
 
-    const T& Back() const noexcept;
-    T& Back() noexcept;
+    // Указатель на первый элемент; в отличие от итераторов не проверяется ни в каком режиме
+    T* Data() noexcept;
+    const T* Data() const noexcept;
 
+#ifdef ADVANCED_VECTOR_CHECKED
+    using iterator = CheckedIterator<Vector, T*>;
+    using const_iterator = CheckedIterator<Vector, const T*>;
+#else
     using iterator = T*;
     using const_iterator = const T*;
+#endif
     using reverse_iterator = std::reverse_iterator<iterator>;
     
     iterator begin() noexcept;
@@ -87,6 +286,16 @@ public:
     const_iterator cbegin() const noexcept;
     const_iterator cend() const noexcept;
 
+    // Представления элементов без копирования; действительны до перераспределения буфера
+    Span<T> AsSpan() noexcept;
+    Span<const T> AsSpan() const noexcept;
+    // count элементов начиная с offset, по умолчанию - до конца
+    Span<T> Subspan(size_t offset, size_t count = DYNAMIC_EXTENT) noexcept;
+    Span<const T> Subspan(size_t offset, size_t count = DYNAMIC_EXTENT) const noexcept;
+    // Каждый stride-й элемент начиная с offset
+    StridedSpan<T> Strided(size_t offset, size_t stride) noexcept;
+    StridedSpan<const T> Strided(size_t offset, size_t stride) const noexcept;
+
     size_t Capacity() const noexcept;
     size_t Size() const noexcept;
 
@@ -101,23 +310,148 @@ public:
 
     iterator Insert(const_iterator pos, const T& value);
     iterator Insert(const_iterator pos, T&& value);
+
+    // Вставки диапазонов выполняют не больше одной реаллокации и одного сдвига хвоста.
+    // Итераторы first и last не должны указывать на элементы самого вектора
+    iterator Insert(const_iterator pos, size_t count, const T& value);
+
+    template <typename InIter, typename = std::enable_if_t<IsInputIterator<InIter>::value>>
+    iterator Insert(const_iterator pos, InIter first, InIter last);
+
+    iterator Insert(const_iterator pos, std::initializer_list<T> init_list);
+
+    template <typename InIter, typename = std::enable_if_t<IsInputIterator<InIter>::value>>
+    void Append(InIter first, InIter last);
+
+    // Добавляет count элементов, построенных из generator(i) или generator(), с одной проверкой
+    // ёмкости и одним обновлением размера. Если генератор или конструктор бросит исключение,
+    // добавленные элементы уничтожаются и размер остаётся прежним; ёмкость может вырасти
+    template <typename Generator>
+    void AppendBatch(size_t count, Generator generator);
+
+    // EmplaceBack без проверки ёмкости: свободное место заранее резервируется через Reserve.
+    // Выход за ёмкость проверяется только assert
+    template <typename... Args>
+    T& EmplaceBackUnchecked(Args&&... args);
+
+    void Assign(size_t count, const T& value);
+
+    template <typename InIter, typename = std::enable_if_t<IsInputIterator<InIter>::value>>
+    void Assign(InIter first, InIter last);
+
+    void Assign(std::initializer_list<T> init_list);
+
+    // Заполняет новый буфер count копиями value параллельно; при исключении вектор не меняется
+    void Assign(ParallelTag policy, size_t count, const T& value);
     
-    void PopBack() noexcept;
+    void PopBack() noexcept(!CHECKED_MODE);
     
-    iterator Erase(const_iterator pos) noexcept(std::is_nothrow_move_assignable_v<T>);
+    iterator Erase(const_iterator pos) noexcept(std::is_nothrow_move_assignable_v<T> && !CHECKED_MODE);
+    iterator Erase(const_iterator first, const_iterator last) noexcept(std::is_nothrow_move_assignable_v<T> && !CHECKED_MODE);
+
+    // Удаляет элемент за O(1), перемещая на его место последний элемент. Порядок элементов не сохраняется
+    iterator SwapRemove(const_iterator pos) noexcept(std::is_nothrow_move_assignable_v<T> && !CHECKED_MODE);
 
     void Reserve(size_t new_capacity);
     void Resize(size_t new_size);
+    void Resize(ParallelTag policy, size_t new_size);
+
+    // Новые элементы инициализируются по умолчанию: тривиальные типы не заполняются нулями
+    void ResizeDefaultInit(size_t new_size);
+
+    // Расширяет вектор до count элементов без инициализации и вызывает op(data, count).
+    // op заполняет буфер и возвращает итоговый размер, не больший count, как
+    // basic_string::resize_and_overwrite. Допустимо для тривиальных и тривиально копируемых
+    // типов; элементы с инициализаторами членов op должна записывать побайтово (memcpy, read)
+    template <typename Operation>
+    void ResizeAndOverwrite(size_t count, Operation op);
 
     void Swap(Vector& other);
 
+    // Удаляет все элементы, сохраняя ёмкость
+    void Clear() noexcept;
+
+    // Уменьшает ёмкость до размера; у пустого вектора буфер освобождается полностью
+    void ShrinkToFit();
+
+    // Передаёт буфер вместе с элементами вызывающему коду без копирования, вектор становится пустым
+    VectorBuffer<T> Release() noexcept;
+
+    // Удаляет текущие элементы и принимает во владение буфер data ёмкостью capacity с size
+    // построенными элементами. Буфер должен быть выделен аллокатором, равным GetAllocator()
+    void Adopt(T* data, size_t size, size_t capacity) noexcept;
+    void Adopt(VectorBuffer<T> buffer) noexcept;
+
     bool Empty();
 
+    const Allocator& GetAllocator() const noexcept;
+
 private:
-    RawMemory<T> data_;
-    size_t size_ = 0;
+    // Рост без выделения нового буфера: аллокатор расширяет память, элементы не перемещаются
+    static constexpr bool GROWS_IN_PLACE = IsTriviallyRelocatable<T>::value && HasReallocate<Allocator>::value;
+
+    static constexpr TransferKind TRANSFER_KIND =
+        IsTriviallyRelocatable<T>::value ? TransferKind::RELOCATED
+        : std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T> ? TransferKind::MOVED
+        : TransferKind::COPIED;
+
+    // Политика с учётом памяти получает изменения размера через AccountedSize
+    using SizeType = std::conditional_t<HasMemoryAccounting<StatsPolicy>::value, AccountedSize<StatsPolicy, T>, size_t>;
+
+    RawMemory<T, Allocator, StatsPolicy> data_;
+    SizeType size_ = 0;
+
+#ifdef ADVANCED_VECTOR_CHECKED
+    // Состояние итераторов текущего буфера, создаётся при первом запросе итератора.
+    // Константные методы заполняют его только через checked_detail::AcquireState
+    mutable std::shared_ptr<checked_detail::IteratorState> iterator_state_;
+#endif
+
+    // Строит элемент перед элементом с номером range
+    template <typename... Args>
+    T* EmplaceAt(size_t range, Args&&... args);
+
+    iterator MakeIterator(T* position) noexcept;
+    const_iterator MakeIterator(const T* position) const noexcept;
+
+    // Адрес элемента под итератором. В проверяемом режиме итератор должен принадлежать
+    // этому вектору и не быть устаревшим
+    T* Unwrap(const_iterator pos) noexcept(!CHECKED_MODE);
+
+    // Итераторы, выданные до смены буфера, становятся недействительными
+    void InvalidateIterators() noexcept;
+    // Отвязывает итераторы от этого вектора и передаёт ему итераторы буфера other
+    void TakeIterators(Vector& other) noexcept;
+
+    void ReinicializationDataIn(RawMemory<T, Allocator, StatsPolicy>& new_data);
+
+    // Ёмкость нового буфера, в который поместится required элементов
+    size_t NextCapacity(size_t required) const noexcept;
+
+    // Выделяет новый буфер тем же аллокатором и сообщает о нём StatsPolicy
+    RawMemory<T, Allocator, StatsPolicy> AllocateBuffer(size_t capacity) const;
 
-    void ReinicializationDataIn(RawMemory<T>& new_data);
+    // Строит count элементов по адресу dst, вызывая construct(first, last) в нескольких потоках
+    template <typename Construct>
+    static void ParallelConstructAt(ParallelTag policy, T* dst, size_t count, Construct construct);
+
+    // Расширяет текущий буфер средствами аллокатора, не перемещая элементы
+    void GrowInPlace(size_t new_capacity);
+
+    // Переносит элементы в new_data, оставляя после range первых элементов промежуток из gap
+    // уже созданных элементов. При исключении уничтожает всё созданное в new_data, включая промежуток
+    void RelocateAroundGap(RawMemory<T, Allocator, StatsPolicy>& new_data, size_t range, size_t gap);
+
+    // Вставляет count элементов, начиная с first, перед pos
+    template <typename ForwardIter>
+    iterator InsertRange(const_iterator pos, ForwardIter first, size_t count);
+
+    // Значение лежит внутри вектора и может быть перемещено или уничтожено при вставке
+    bool IsOwnElement(const T& value) const noexcept;
+
+    // Присваивает count элементов, начиная с first, переиспользуя уже выделенную память
+    template<typename InIter>
+    void AssignFrom(InIter first, size_t count);
 
     //Шаблонный метод не осуществляет освобождение памяти
     template<typename InIter, typename OutIter>
@@ -125,157 +459,328 @@ private:
 };
 
 //-------------------------RAW_MEMORY---------------------
-template <typename T>
-inline  RawMemory<T>::RawMemory(size_t capacity) : buffer_(Allocate(capacity)), 
-                                                   capacity_(capacity) {
+template <typename T, typename Allocator, typename StatsPolicy>
+inline RawMemory<T, Allocator, StatsPolicy>::RawMemory(const Allocator& alloc) noexcept : alloc_(alloc) {
 }
 
-template <typename T>
-inline RawMemory<T>::~RawMemory() {
-    Deallocate(buffer_);
+template <typename T, typename Allocator, typename StatsPolicy>
+inline RawMemory<T, Allocator, StatsPolicy>::RawMemory(size_t capacity, const Allocator& alloc) : alloc_(alloc) {
+    buffer_ = Allocate(capacity);
+    capacity_ = UsableCapacity(buffer_, capacity);
+    if (buffer_ != nullptr) {
+        AccountAcquire(capacity_);
+    }
 }
 
-template <typename T>
-inline RawMemory<T>::RawMemory(RawMemory&& other) noexcept {
-    this->Swap(other);
+template <typename T, typename Allocator, typename StatsPolicy>
+inline RawMemory<T, Allocator, StatsPolicy>::~RawMemory() {
+    Deallocate(buffer_, capacity_);
 }
 
-template <typename T>
-inline RawMemory<T>& RawMemory<T>::operator=(RawMemory&& rhs) noexcept {
+template <typename T, typename Allocator, typename StatsPolicy>
+inline RawMemory<T, Allocator, StatsPolicy>::RawMemory(RawMemory&& other) noexcept : buffer_(std::exchange(other.buffer_, nullptr)),
+                                                                        capacity_(std::exchange(other.capacity_, 0)),
+                                                                        alloc_(std::move(other.alloc_)) {
+}
+
+template <typename T, typename Allocator, typename StatsPolicy>
+inline RawMemory<T, Allocator, StatsPolicy>& RawMemory<T, Allocator, StatsPolicy>::operator=(RawMemory&& rhs) noexcept {
     if(this != &rhs) {
-        Swap(rhs);
+        Deallocate(buffer_, capacity_);
+
+        if constexpr (AllocTraits::propagate_on_container_move_assignment::value) {
+            alloc_ = std::move(rhs.alloc_);
+        } else {
+            assert(alloc_ == rhs.alloc_);
+        }
+
+        buffer_ = std::exchange(rhs.buffer_, nullptr);
+        capacity_ = std::exchange(rhs.capacity_, 0);
     }
 
     return *this;     
 }
 
-template <typename T>
-inline T* RawMemory<T>::operator+(size_t offset) noexcept {
+template <typename T, typename Allocator, typename StatsPolicy>
+inline T* RawMemory<T, Allocator, StatsPolicy>::operator+(size_t offset) noexcept {
     // Разрешается получать адрес ячейки памяти, следующей за последним элементом массива
     assert(offset <= capacity_);
     return buffer_ + offset;
 }
 
-template <typename T>
-inline const T* RawMemory<T>::operator+(size_t offset) const noexcept {
+template <typename T, typename Allocator, typename StatsPolicy>
+inline const T* RawMemory<T, Allocator, StatsPolicy>::operator+(size_t offset) const noexcept {
     return const_cast<RawMemory&>(*this) + offset;
 }
 
-template <typename T>
-inline const T& RawMemory<T>::operator[](size_t index) const noexcept {
+template <typename T, typename Allocator, typename StatsPolicy>
+inline const T& RawMemory<T, Allocator, StatsPolicy>::operator[](size_t index) const noexcept {
     return const_cast<RawMemory&>(*this)[index];
 }
 
-template <typename T>
-inline T& RawMemory<T>::operator[](size_t index) noexcept {
+template <typename T, typename Allocator, typename StatsPolicy>
+inline T& RawMemory<T, Allocator, StatsPolicy>::operator[](size_t index) noexcept {
     assert(index < capacity_);
     return buffer_[index];
 }
 
-template <typename T>
-inline void RawMemory<T>::Swap(RawMemory& other) noexcept {
+template <typename T, typename Allocator, typename StatsPolicy>
+inline void RawMemory<T, Allocator, StatsPolicy>::Swap(RawMemory& other) noexcept {
+    if constexpr (AllocTraits::propagate_on_container_swap::value) {
+        using std::swap;
+        swap(alloc_, other.alloc_);
+    } else {
+        assert(alloc_ == other.alloc_);
+    }
+
     std::swap(buffer_, other.buffer_);
     std::swap(capacity_, other.capacity_);
 }
 
-template <typename T>
-inline const T* RawMemory<T>::GetAddress() const noexcept {
+template <typename T, typename Allocator, typename StatsPolicy>
+inline void RawMemory<T, Allocator, StatsPolicy>::Reset(const Allocator& alloc) noexcept {
+    Deallocate(buffer_, capacity_);
+    buffer_ = nullptr;
+    capacity_ = 0;
+    alloc_ = alloc;
+}
+
+template <typename T, typename Allocator, typename StatsPolicy>
+inline T* RawMemory<T, Allocator, StatsPolicy>::Release() noexcept {
+    if (buffer_ != nullptr) {
+        AccountRelease(capacity_);
+    }
+    capacity_ = 0;
+    return std::exchange(buffer_, nullptr);
+}
+
+template <typename T, typename Allocator, typename StatsPolicy>
+inline void RawMemory<T, Allocator, StatsPolicy>::Adopt(T* buf, size_t capacity) noexcept {
+    assert(buf != buffer_ || buf == nullptr);
+
+    Deallocate(buffer_, capacity_);
+    buffer_ = buf;
+    capacity_ = buf != nullptr ? capacity : 0;
+    if (buf != nullptr) {
+        AccountAcquire(capacity_);
+    }
+}
+
+template <typename T, typename Allocator, typename StatsPolicy>
+inline void RawMemory<T, Allocator, StatsPolicy>::Reallocate(size_t new_capacity) {
+    static_assert(IsTriviallyRelocatable<T>::value && HasReallocate<Allocator>::value);
+
+    T* new_buffer = alloc_.reallocate(buffer_, capacity_, new_capacity);
+    if (buffer_ != nullptr) {
+        AccountRelease(capacity_);
+    }
+    buffer_ = new_buffer;
+    capacity_ = UsableCapacity(buffer_, new_capacity);
+    if (buffer_ != nullptr) {
+        AccountAcquire(capacity_);
+    }
+}
+
+template <typename T, typename Allocator, typename StatsPolicy>
+inline const T* RawMemory<T, Allocator, StatsPolicy>::GetAddress() const noexcept {
     return buffer_;
 }
 
-template <typename T>
-inline T* RawMemory<T>::GetAddress() noexcept {
+template <typename T, typename Allocator, typename StatsPolicy>
+inline T* RawMemory<T, Allocator, StatsPolicy>::GetAddress() noexcept {
     return buffer_;
 }
 
-template <typename T>
-inline size_t RawMemory<T>::Capacity() const {
+template <typename T, typename Allocator, typename StatsPolicy>
+inline size_t RawMemory<T, Allocator, StatsPolicy>::Capacity() const {
     return capacity_;
 }
 
-template <typename T>
-inline T* RawMemory<T>::Allocate(size_t n) {
-    return n != 0 ? static_cast<T*>(operator new(n* sizeof(T))) : nullptr;
+template <typename T, typename Allocator, typename StatsPolicy>
+inline const Allocator& RawMemory<T, Allocator, StatsPolicy>::GetAllocator() const noexcept {
+    return alloc_;
 }
 
-template <typename T>
-inline void RawMemory<T>::Deallocate(T* buf) noexcept {
-     operator delete(buf);
+template <typename T, typename Allocator, typename StatsPolicy>
+inline T* RawMemory<T, Allocator, StatsPolicy>::Allocate(size_t n) {
+    return n != 0 ? AllocTraits::allocate(alloc_, n) : nullptr;
+}
+
+template <typename T, typename Allocator, typename StatsPolicy>
+inline size_t RawMemory<T, Allocator, StatsPolicy>::UsableCapacity(T* buf, size_t n) const noexcept {
+    if constexpr (HasUsableSize<Allocator>::value) {
+        return buf != nullptr ? alloc_.usable_size(buf, n) : n;
+    } else {
+        return n;
+    }
+}
+
+template <typename T, typename Allocator, typename StatsPolicy>
+inline void RawMemory<T, Allocator, StatsPolicy>::Deallocate(T* buf, size_t n) noexcept {
+    if (buf != nullptr) {
+        AccountRelease(n);
+        AllocTraits::deallocate(alloc_, buf, n);
+    }
+}
+
+template <typename T, typename Allocator, typename StatsPolicy>
+inline void RawMemory<T, Allocator, StatsPolicy>::AccountAcquire([[maybe_unused]] size_t capacity) noexcept {
+    if constexpr (HasMemoryAccounting<StatsPolicy>::value) {
+        StatsPolicy::OnBufferAcquire(capacity * sizeof(T));
+    }
+}
+
+template <typename T, typename Allocator, typename StatsPolicy>
+inline void RawMemory<T, Allocator, StatsPolicy>::AccountRelease([[maybe_unused]] size_t capacity) noexcept {
+    if constexpr (HasMemoryAccounting<StatsPolicy>::value) {
+        StatsPolicy::OnBufferRelease(capacity * sizeof(T));
+    }
 }
 
 //-------------------------VECTOR---------------------
-template <typename T>
-inline Vector<T>::~Vector() {
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline Vector<T, Allocator, GrowthPolicy, StatsPolicy>::~Vector() {
+#ifdef ADVANCED_VECTOR_CHECKED
+    if (iterator_state_ != nullptr) {
+        iterator_state_->owner = nullptr;
+    }
+#endif
     std::destroy_n(data_.GetAddress(), size_);
 }
 
-template <typename T>
-inline Vector<T>::Vector(size_t size) : data_(size),
-                                        size_(size) {
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline Vector<T, Allocator, GrowthPolicy, StatsPolicy>::Vector(const Allocator& alloc) noexcept : data_(alloc) {
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline Vector<T, Allocator, GrowthPolicy, StatsPolicy>::Vector(size_t size, const Allocator& alloc) : data_(size, alloc),
+                                                                           size_(size) {
+    StatsPolicy::OnAllocate(data_.Capacity(), data_.Capacity() * sizeof(T));
     std::uninitialized_value_construct_n(data_.GetAddress(), size);  
 }
 
-template <typename T>
-inline Vector<T>::Vector(std::initializer_list<T> init_list) : data_(init_list.size()),
-                                                               size_(init_list.size()) {
-    std::move(init_list.begin(), init_list.end(), this->begin());
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline Vector<T, Allocator, GrowthPolicy, StatsPolicy>::Vector(size_t size, DefaultInitTag, const Allocator& alloc) : data_(size, alloc),
+                                                                                                         size_(size) {
+    StatsPolicy::OnAllocate(data_.Capacity(), data_.Capacity() * sizeof(T));
+    std::uninitialized_default_construct_n(data_.GetAddress(), size);
 }
 
-template <typename T>
-inline Vector<T>::Vector(const Vector& other) : data_(other.size_),
-                                                size_(other.size_) {
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline Vector<T, Allocator, GrowthPolicy, StatsPolicy>::Vector(std::initializer_list<T> init_list, const Allocator& alloc) 
+    : Vector(init_list.begin(), init_list.end(), alloc) {
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+template <typename InIter, typename>
+inline Vector<T, Allocator, GrowthPolicy, StatsPolicy>::Vector(InIter first, InIter last, const Allocator& alloc) : data_(alloc) {
+    if constexpr (IsForwardIterator<InIter>::value) {
+        const size_t count = static_cast<size_t>(std::distance(first, last));
+        RawMemory<T, Allocator, StatsPolicy> new_data = AllocateBuffer(count);
+        std::uninitialized_copy_n(first, count, new_data.GetAddress());
+
+        data_.Swap(new_data);
+        size_ = count;
+    } else {
+        Append(first, last);
+    }
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline Vector<T, Allocator, GrowthPolicy, StatsPolicy>::Vector(const Vector& other) 
+    : Vector(other, AllocTraits::select_on_container_copy_construction(other.GetAllocator())) {
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline Vector<T, Allocator, GrowthPolicy, StatsPolicy>::Vector(const Vector& other, const Allocator& alloc) : data_(other.size_, alloc),
+                                                                                   size_(other.size_) {
+    StatsPolicy::OnAllocate(data_.Capacity(), data_.Capacity() * sizeof(T));
     std::uninitialized_copy_n(other.data_.GetAddress(), size_, data_.GetAddress());   
 }
 
-template <typename T>
-inline Vector<T>::Vector(Vector&& other) {
-    Swap(other);
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline Vector<T, Allocator, GrowthPolicy, StatsPolicy>::Vector(ParallelTag policy, size_t size, const Allocator& alloc) : data_(size, alloc),
+                                                                                                           size_(size) {
+    StatsPolicy::OnAllocate(data_.Capacity(), data_.Capacity() * sizeof(T));
+    ParallelConstructAt(policy, data_.GetAddress(), size, [](T* first, T* last) {
+        std::uninitialized_value_construct(first, last);
+    });
 }
 
-template <typename T>
-inline Vector<T>& Vector<T>::operator=(const Vector& other) {
-    if (this != &other) {
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline Vector<T, Allocator, GrowthPolicy, StatsPolicy>::Vector(ParallelTag policy, const Vector& other)
+    : data_(other.size_, AllocTraits::select_on_container_copy_construction(other.GetAllocator())),
+      size_(other.size_) {
+    StatsPolicy::OnAllocate(data_.Capacity(), data_.Capacity() * sizeof(T));
+
+    const T* source = other.data_.GetAddress();
+    T* destination = data_.GetAddress();
+    ParallelConstructAt(policy, destination, size_, [source, destination](T* first, T* last) {
+        std::uninitialized_copy(source + (first - destination), source + (last - destination), first);
+    });
+}
 
-        if (other.size_ > data_.Capacity()) {
-            Vector new_data(other);
-            Swap(new_data);
-        } else {
-            std::copy_n(other.data_.GetAddress(), std::min(other.size_, size_), data_.GetAddress());
-            
-            if(other.size_ < size_) {    
-                std::destroy_n(data_+ other.size_, size_ - other.size_);
-            } else {
-                std::uninitialized_copy_n(other.data_ + size_, other.size_ - size_, data_ + size_);
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline Vector<T, Allocator, GrowthPolicy, StatsPolicy>::Vector(Vector&& other) noexcept : data_(std::move(other.data_)),
+                                                      size_(std::exchange(other.size_, 0)) {
+    TakeIterators(other);
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline Vector<T, Allocator, GrowthPolicy, StatsPolicy>& Vector<T, Allocator, GrowthPolicy, StatsPolicy>::operator=(const Vector& other) {
+    if (this != &other) {
+        if constexpr (AllocTraits::propagate_on_container_copy_assignment::value) {
+            if (data_.GetAllocator() != other.data_.GetAllocator()) {
+                // Память, выделенная прежним аллокатором, должна быть им же и освобождена
+                std::destroy_n(data_.GetAddress(), size_);
+                size_ = 0;
+                data_.Reset(other.data_.GetAllocator());
+                InvalidateIterators();
             }
-            size_ = other.size_;
         }
+
+        AssignFrom(other.data_.GetAddress(), other.size_);
     }
 
     return *this;
 }
 
-template <typename T>
-inline Vector<T>& Vector<T>::operator=(Vector&& other) {
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline Vector<T, Allocator, GrowthPolicy, StatsPolicy>& Vector<T, Allocator, GrowthPolicy, StatsPolicy>::operator=(Vector&& other) noexcept(AllocTraits::propagate_on_container_move_assignment::value
+                                                                                                                      || AllocTraits::is_always_equal::value) {
     if(this != &other) {
-        Swap(other);
+        if constexpr (AllocTraits::propagate_on_container_move_assignment::value || AllocTraits::is_always_equal::value) {
+            std::destroy_n(data_.GetAddress(), size_);
+            data_ = std::move(other.data_);
+            size_ = std::exchange(other.size_, 0);
+            TakeIterators(other);
+        } else if (data_.GetAllocator() == other.data_.GetAllocator()) {
+            std::destroy_n(data_.GetAddress(), size_);
+            data_ = std::move(other.data_);
+            size_ = std::exchange(other.size_, 0);
+            TakeIterators(other);
+        } else {
+            // Память other нельзя забрать себе: она освобождается чужим аллокатором
+            AssignFrom(std::make_move_iterator(other.data_.GetAddress()), other.size_);
+        }
     }
 
     return *this;
 }
 
-template <typename T>
-inline const T& Vector<T>::operator[](size_t index) const noexcept {
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline const T& Vector<T, Allocator, GrowthPolicy, StatsPolicy>::operator[](size_t index) const noexcept(!CHECKED_MODE) {
     return const_cast<Vector&>(*this)[index];
 }
 
-template <typename T>
-inline T& Vector<T>::operator[](size_t index) noexcept {
-    assert(index < size_);
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline T& Vector<T, Allocator, GrowthPolicy, StatsPolicy>::operator[](size_t index) noexcept(!CHECKED_MODE) {
+    VECTOR_CHECK(index < size_, "vector index out of range");
     return data_[index];
 }
 
-template <typename T>
-inline const T& Vector<T>::At(size_t index) const noexcept {
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline const T& Vector<T, Allocator, GrowthPolicy, StatsPolicy>::At(size_t index) const {
     if(index >= size_){
         throw std::out_of_range("Out of vector range");
     }
@@ -283,8 +788,8 @@ inline const T& Vector<T>::At(size_t index) const noexcept {
     return data_[index];
 }
 
-template <typename T>
-inline T& Vector<T>::At(size_t index) noexcept {
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline T& Vector<T, Allocator, GrowthPolicy, StatsPolicy>::At(size_t index) {
     if(index >= size_){
         throw std::out_of_range("Out of vector range");
     }
@@ -292,161 +797,421 @@ inline T& Vector<T>::At(size_t index) noexcept {
     return data_[index];
 }
 
-template <typename T>
-inline const T& Vector<T>::Front() const noexcept {
-    return data_[0];
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline const T& Vector<T, Allocator, GrowthPolicy, StatsPolicy>::Front() const noexcept(!CHECKED_MODE) {
+    return const_cast<Vector&>(*this).Front();
 }
 
-template <typename T>
-inline T& Vector<T>::Front() noexcept {
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline T& Vector<T, Allocator, GrowthPolicy, StatsPolicy>::Front() noexcept(!CHECKED_MODE) {
+    VECTOR_CHECK(size_ != 0, "Front() of an empty vector");
     return data_[0];
 }
 
-template <typename T>
-inline const T& Vector<T>::Back() const noexcept {
-    return data_[size_ - 1];
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline const T& Vector<T, Allocator, GrowthPolicy, StatsPolicy>::Back() const noexcept(!CHECKED_MODE) {
+    return const_cast<Vector&>(*this).Back();
 }
 
-template <typename T>
-inline T &Vector<T>::Back() noexcept {
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline T &Vector<T, Allocator, GrowthPolicy, StatsPolicy>::Back() noexcept(!CHECKED_MODE) {
+    VECTOR_CHECK(size_ != 0, "Back() of an empty vector");
     return data_[size_ - 1];
 }
 
-template <typename T>
-inline typename Vector<T>::iterator Vector<T>::begin() noexcept {
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline T* Vector<T, Allocator, GrowthPolicy, StatsPolicy>::Data() noexcept {
     return data_.GetAddress();
 }
 
-template <typename T>
-inline typename Vector<T>::iterator Vector<T>::end() noexcept {
-    return data_ + size_;
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline const T* Vector<T, Allocator, GrowthPolicy, StatsPolicy>::Data() const noexcept {
+    return data_.GetAddress();
 }
 
-template <typename T>
-inline typename Vector<T>::reverse_iterator Vector<T>::rbegin() noexcept {
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline typename Vector<T, Allocator, GrowthPolicy, StatsPolicy>::iterator Vector<T, Allocator, GrowthPolicy, StatsPolicy>::begin() noexcept {
+    return MakeIterator(data_.GetAddress());
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline typename Vector<T, Allocator, GrowthPolicy, StatsPolicy>::iterator Vector<T, Allocator, GrowthPolicy, StatsPolicy>::end() noexcept {
+    return MakeIterator(data_ + size_);
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline typename Vector<T, Allocator, GrowthPolicy, StatsPolicy>::reverse_iterator Vector<T, Allocator, GrowthPolicy, StatsPolicy>::rbegin() noexcept {
     return reverse_iterator(end());
 }
 
-template <typename T>
-inline typename Vector<T>::reverse_iterator Vector<T>::rend() noexcept {
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline typename Vector<T, Allocator, GrowthPolicy, StatsPolicy>::reverse_iterator Vector<T, Allocator, GrowthPolicy, StatsPolicy>::rend() noexcept {
     return reverse_iterator(begin());
 }
 
-template <typename T>
-inline typename Vector<T>::const_iterator Vector<T>::begin() const noexcept {
-    return data_.GetAddress();
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline typename Vector<T, Allocator, GrowthPolicy, StatsPolicy>::const_iterator Vector<T, Allocator, GrowthPolicy, StatsPolicy>::begin() const noexcept {
+    return MakeIterator(data_.GetAddress());
 }
 
-template <typename T>
-inline typename Vector<T>::const_iterator Vector<T>::end() const noexcept {
-    return data_ + size_;
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline typename Vector<T, Allocator, GrowthPolicy, StatsPolicy>::const_iterator Vector<T, Allocator, GrowthPolicy, StatsPolicy>::end() const noexcept {
+    return MakeIterator(data_ + size_);
 }
 
-template <typename T>
-inline typename Vector<T>::const_iterator Vector<T>::cbegin() const noexcept {
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline typename Vector<T, Allocator, GrowthPolicy, StatsPolicy>::const_iterator Vector<T, Allocator, GrowthPolicy, StatsPolicy>::cbegin() const noexcept {
     return begin();
 }
 
-template <typename T>
-inline typename Vector<T>::const_iterator Vector<T>::cend() const noexcept {
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline typename Vector<T, Allocator, GrowthPolicy, StatsPolicy>::const_iterator Vector<T, Allocator, GrowthPolicy, StatsPolicy>::cend() const noexcept {
     return end();
 }
 
-template <typename T>
-inline size_t Vector<T>::Capacity() const noexcept {
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline Span<T> Vector<T, Allocator, GrowthPolicy, StatsPolicy>::AsSpan() noexcept {
+    return Span<T>(data_.GetAddress(), size_);
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline Span<const T> Vector<T, Allocator, GrowthPolicy, StatsPolicy>::AsSpan() const noexcept {
+    return Span<const T>(data_.GetAddress(), size_);
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline Span<T> Vector<T, Allocator, GrowthPolicy, StatsPolicy>::Subspan(size_t offset, size_t count) noexcept {
+    return AsSpan().Subspan(offset, count);
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline Span<const T> Vector<T, Allocator, GrowthPolicy, StatsPolicy>::Subspan(size_t offset, size_t count) const noexcept {
+    return AsSpan().Subspan(offset, count);
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline StridedSpan<T> Vector<T, Allocator, GrowthPolicy, StatsPolicy>::Strided(size_t offset, size_t stride) noexcept {
+    return AsSpan().Subspan(offset).Strided(stride);
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline StridedSpan<const T> Vector<T, Allocator, GrowthPolicy, StatsPolicy>::Strided(size_t offset, size_t stride) const noexcept {
+    return AsSpan().Subspan(offset).Strided(stride);
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline size_t Vector<T, Allocator, GrowthPolicy, StatsPolicy>::Capacity() const noexcept {
     return data_.Capacity();
 }
 
-template <typename T>
-inline size_t Vector<T>::Size() const noexcept {
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline size_t Vector<T, Allocator, GrowthPolicy, StatsPolicy>::Size() const noexcept {
     return size_;
 }
 
-template <typename T>
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
 template <typename Value>
-inline void Vector<T>::PushBack(Value&& value) {
+inline void Vector<T, Allocator, GrowthPolicy, StatsPolicy>::PushBack(Value&& value) {
     EmplaceBack(std::forward<Value>(value));
 }
 
-template <typename T>
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
 template <typename... Args>
-inline T& Vector<T>::EmplaceBack(Args&&... args) {
-    return *Emplace(data_ + size_, std::forward<Args>(args)...);
+inline T& Vector<T, Allocator, GrowthPolicy, StatsPolicy>::EmplaceBack(Args&&... args) {
+    if (size_ < data_.Capacity()) {
+        T* element = new (data_ + size_) T(std::forward<Args>(args)...);
+        ++size_;
+        return *element;
+    }
+
+    if constexpr (GROWS_IN_PLACE) {
+        return *EmplaceAt(size_, std::forward<Args>(args)...);
+    } else {
+        // Элемент строится в новом буфере до переноса: args могут ссылаться на элементы вектора
+        RawMemory<T, Allocator, StatsPolicy> new_data = AllocateBuffer(NextCapacity(size_ + 1));
+        T* element = new (new_data + size_) T(std::forward<Args>(args)...);
+
+        StatsPolicy::OnReallocate(data_.Capacity(), new_data.Capacity());
+        try {
+            ReinicializationDataIn(new_data);
+        } catch (...) {
+            std::destroy_at(element);
+            throw;
+        }
+        ++size_;
+        return *element;
+    }
 }
 
-template <typename T>
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
 template <typename... Args>
-inline typename Vector<T>::iterator Vector<T>::Emplace(const_iterator pos, Args&&... args) {
-    assert(pos >= begin() && pos <= end());
+inline typename Vector<T, Allocator, GrowthPolicy, StatsPolicy>::iterator Vector<T, Allocator, GrowthPolicy, StatsPolicy>::Emplace(const_iterator pos, Args&&... args) {
+    T* position = Unwrap(pos);
+    VECTOR_CHECK(position >= data_.GetAddress() && position <= data_ + size_, "Emplace position out of range");
 
-    size_t range = pos - begin();
+    return MakeIterator(EmplaceAt(position - data_.GetAddress(), std::forward<Args>(args)...));
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+template <typename... Args>
+inline T* Vector<T, Allocator, GrowthPolicy, StatsPolicy>::EmplaceAt(size_t range, Args&&... args) {
     if(size_ < data_.Capacity()) {
 
-        if(pos == end()) {
-            new(end()) T(std::forward<Args>(args)...);
+        if(range == size_) {
+            new(data_ + size_) T(std::forward<Args>(args)...);
+        } else if constexpr (IsTriviallyRelocatable<T>::value) {
+            // Элемент собирается во временном буфере: args могут ссылаться на элементы вектора
+            alignas(T) std::byte temp_value[sizeof(T)];
+            new (temp_value) T(std::forward<Args>(args)...);
+            StatsPolicy::OnShift(size_ - range);
+            RelocateN(data_ + range, size_ - range, data_ + range + 1);
+            RelocateN(reinterpret_cast<T*>(temp_value), 1, data_ + range);
         } else {
             T temp_value(std::forward<Args>(args)...);
-            new (end()) T(std::forward<T>(data_[size_ - 1]));
-            std::move_backward(iterator(pos), end() - 1, end());
+            StatsPolicy::OnShift(size_ - range);
+            T* old_end = data_ + size_;
+            new (old_end) T(std::forward<T>(data_[size_ - 1]));
+            std::move_backward(data_ + range, old_end - 1, old_end);
             data_[range] = std::move(temp_value);
         }
+    } else if constexpr (GROWS_IN_PLACE) {
+        alignas(T) std::byte temp_value[sizeof(T)];
+        T* temp = new (temp_value) T(std::forward<Args>(args)...);
+
+        try {
+            GrowInPlace(NextCapacity(size_ + 1));
+        } catch (...) {
+            std::destroy_at(temp);
+            throw;
+        }
+
+        StatsPolicy::OnShift(size_ - range);
+        RelocateN(data_ + range, size_ - range, data_ + range + 1);
+        RelocateN(temp, 1, data_ + range);
     } else {
-        RawMemory<T> new_data(size_ == 0 ? 1 : size_ * 2);
+        RawMemory<T, Allocator, StatsPolicy> new_data = AllocateBuffer(NextCapacity(size_ + 1));
         new(new_data + range) T(std::forward<Args>(args)...);
 
-        ReinicializationDataIn(begin(), iterator(pos), new_data.GetAddress());
-        ReinicializationDataIn(iterator(pos), end(), new_data + range + 1);
-
-        std::destroy_n(data_.GetAddress(), size_);
+        RelocateAroundGap(new_data, range, 1);
+        StatsPolicy::OnReallocate(data_.Capacity(), new_data.Capacity());
         data_.Swap(new_data);
+        InvalidateIterators();
     }
     ++size_;
 
     return data_ + range;
 }
 
-template <typename T>
-inline typename Vector<T>::iterator Vector<T>::Insert(const_iterator pos, const T &value) {
-    assert(pos >= begin() && pos <= end() );
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline typename Vector<T, Allocator, GrowthPolicy, StatsPolicy>::iterator Vector<T, Allocator, GrowthPolicy, StatsPolicy>::Insert(const_iterator pos, const T &value) {
     return Emplace(pos, value);
 }
 
-template <typename T>
-inline typename Vector<T>::iterator Vector<T>::Insert(const_iterator pos, T&& value) {
-    assert(pos >= begin() && pos <= end() );
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline typename Vector<T, Allocator, GrowthPolicy, StatsPolicy>::iterator Vector<T, Allocator, GrowthPolicy, StatsPolicy>::Insert(const_iterator pos, T&& value) {
     return Emplace(pos, std::move(value));
 }
 
-template <typename T>
-inline void Vector<T>::PopBack() noexcept {
-    assert(!Empty());
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline typename Vector<T, Allocator, GrowthPolicy, StatsPolicy>::iterator Vector<T, Allocator, GrowthPolicy, StatsPolicy>::Insert(const_iterator pos, size_t count, const T& value) {
+    if (IsOwnElement(value)) {
+        const T value_copy(value);
+        return InsertRange(pos, RepeatIterator<T>(value_copy), count);
+    }
+
+    return InsertRange(pos, RepeatIterator<T>(value), count);
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+template <typename InIter, typename>
+inline typename Vector<T, Allocator, GrowthPolicy, StatsPolicy>::iterator Vector<T, Allocator, GrowthPolicy, StatsPolicy>::Insert(const_iterator pos, InIter first, InIter last) {
+    if constexpr (IsForwardIterator<InIter>::value) {
+        return InsertRange(pos, first, static_cast<size_t>(std::distance(first, last)));
+    } else {
+        // Однопроходный диапазон сначала собирается целиком, чтобы узнать его длину
+        Vector temp(first, last, data_.GetAllocator());
+        return InsertRange(pos, std::make_move_iterator(temp.Data()), temp.size_);
+    }
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline typename Vector<T, Allocator, GrowthPolicy, StatsPolicy>::iterator Vector<T, Allocator, GrowthPolicy, StatsPolicy>::Insert(const_iterator pos, std::initializer_list<T> init_list) {
+    return InsertRange(pos, init_list.begin(), init_list.size());
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+template <typename InIter, typename>
+inline void Vector<T, Allocator, GrowthPolicy, StatsPolicy>::Append(InIter first, InIter last) {
+    if constexpr (IsForwardIterator<InIter>::value) {
+        InsertRange(cend(), first, static_cast<size_t>(std::distance(first, last)));
+    } else {
+        for (; first != last; ++first) {
+            EmplaceBack(*first);
+        }
+    }
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+template <typename Generator>
+inline void Vector<T, Allocator, GrowthPolicy, StatsPolicy>::AppendBatch(size_t count, Generator generator) {
+    if (size_ + count > data_.Capacity()) {
+        Reserve(NextCapacity(size_ + count));
+    }
+
+    // Размер до конца цикла не меняется, поэтому адрес записи считается один раз
+    T* const first = data_ + size_;
+    size_t built = 0;
+    try {
+        for (; built != count; ++built) {
+            if constexpr (std::is_invocable_v<Generator&, size_t>) {
+                new (first + built) T(generator(built));
+            } else {
+                new (first + built) T(generator());
+            }
+        }
+    } catch (...) {
+        std::destroy_n(first, built);
+        throw;
+    }
+    size_ += count;
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+template <typename... Args>
+inline T& Vector<T, Allocator, GrowthPolicy, StatsPolicy>::EmplaceBackUnchecked(Args&&... args) {
+    VECTOR_CHECK(size_ < data_.Capacity(), "EmplaceBackUnchecked without reserved capacity");
+    T* element = new (data_ + size_) T(std::forward<Args>(args)...);
+    ++size_;
+    return *element;
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline void Vector<T, Allocator, GrowthPolicy, StatsPolicy>::Assign(size_t count, const T& value) {
+    if (IsOwnElement(value)) {
+        const T value_copy(value);
+        AssignFrom(RepeatIterator<T>(value_copy), count);
+    } else {
+        AssignFrom(RepeatIterator<T>(value), count);
+    }
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+template <typename InIter, typename>
+inline void Vector<T, Allocator, GrowthPolicy, StatsPolicy>::Assign(InIter first, InIter last) {
+    if constexpr (IsForwardIterator<InIter>::value) {
+        AssignFrom(first, static_cast<size_t>(std::distance(first, last)));
+    } else {
+        Vector temp(first, last, data_.GetAllocator());
+        AssignFrom(std::make_move_iterator(temp.Data()), temp.size_);
+    }
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline void Vector<T, Allocator, GrowthPolicy, StatsPolicy>::Assign(std::initializer_list<T> init_list) {
+    AssignFrom(init_list.begin(), init_list.size());
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline void Vector<T, Allocator, GrowthPolicy, StatsPolicy>::Assign(ParallelTag policy, size_t count, const T& value) {
+    RawMemory<T, Allocator, StatsPolicy> new_data = AllocateBuffer(count);
+    ParallelConstructAt(policy, new_data.GetAddress(), count, [&value](T* first, T* last) {
+        std::uninitialized_fill(first, last, value);
+    });
+
+    std::destroy_n(data_.GetAddress(), size_);
+    data_.Swap(new_data);
+    InvalidateIterators();
+    size_ = count;
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline void Vector<T, Allocator, GrowthPolicy, StatsPolicy>::PopBack() noexcept(!CHECKED_MODE) {
+    VECTOR_CHECK(size_ != 0, "PopBack() of an empty vector");
 
     std::destroy_at(data_ + (size_ - 1));
     --size_;
 }
 
-template <typename T>
-inline typename Vector<T>::iterator Vector<T>::Erase(const_iterator pos) noexcept(std::is_nothrow_move_assignable_v<T>) {
-    assert(pos >= begin() && pos < end());
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline typename Vector<T, Allocator, GrowthPolicy, StatsPolicy>::iterator Vector<T, Allocator, GrowthPolicy, StatsPolicy>::Erase(const_iterator pos) noexcept(std::is_nothrow_move_assignable_v<T> && !CHECKED_MODE) {
+    T* position = Unwrap(pos);
+    T* old_end = data_ + size_;
+    VECTOR_CHECK(position >= data_.GetAddress() && position < old_end, "Erase position out of range");
+
+    StatsPolicy::OnShift(old_end - position - 1);
+    if constexpr (IsTriviallyRelocatable<T>::value) {
+        std::destroy_at(position);
+        RelocateN(position + 1, old_end - position - 1, position);
+        --size_;
+    } else {
+        std::move(position + 1, old_end, position);
+        PopBack();
+    }
 
-    std::move(iterator(pos) + 1, end(), iterator(pos));
-    PopBack();
+    return MakeIterator(position);
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline typename Vector<T, Allocator, GrowthPolicy, StatsPolicy>::iterator Vector<T, Allocator, GrowthPolicy, StatsPolicy>::Erase(const_iterator first, const_iterator last) noexcept(std::is_nothrow_move_assignable_v<T> && !CHECKED_MODE) {
+    T* erase_first = Unwrap(first);
+    T* erase_last = Unwrap(last);
+    T* old_end = data_ + size_;
+    VECTOR_CHECK(erase_first >= data_.GetAddress() && erase_first <= erase_last && erase_last <= old_end,
+                 "Erase range out of range");
+
+    const size_t count = erase_last - erase_first;
+    StatsPolicy::OnShift(old_end - erase_last);
+    if constexpr (IsTriviallyRelocatable<T>::value) {
+        std::destroy_n(erase_first, count);
+        RelocateN(erase_last, old_end - erase_last, erase_first);
+    } else {
+        T* new_end = std::move(erase_last, old_end, erase_first);
+        std::destroy_n(new_end, count);
+    }
+    size_ -= count;
 
-    return iterator(pos);
+    return MakeIterator(erase_first);
 }
 
-template <typename T>
-inline void Vector<T>::Reserve(size_t new_capacity) {
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline typename Vector<T, Allocator, GrowthPolicy, StatsPolicy>::iterator Vector<T, Allocator, GrowthPolicy, StatsPolicy>::SwapRemove(const_iterator pos) noexcept(std::is_nothrow_move_assignable_v<T> && !CHECKED_MODE) {
+    T* position = Unwrap(pos);
+    VECTOR_CHECK(position >= data_.GetAddress() && position < data_ + size_, "SwapRemove position out of range");
+
+    T* last = data_ + (size_ - 1);
+    if constexpr (IsTriviallyRelocatable<T>::value) {
+        std::destroy_at(position);
+        if (position != last) {
+            RelocateN(last, 1, position);
+        }
+        --size_;
+    } else {
+        if (position != last) {
+            *position = std::move(*last);
+        }
+        PopBack();
+    }
+
+    return MakeIterator(position);
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline void Vector<T, Allocator, GrowthPolicy, StatsPolicy>::Reserve(size_t new_capacity) {
     if (new_capacity <= data_.Capacity()) {
         return;
     }
 
-    RawMemory<T> new_data(new_capacity);
-    ReinicializationDataIn(new_data);     
+    if constexpr (GROWS_IN_PLACE) {
+        GrowInPlace(new_capacity);
+    } else {
+        RawMemory<T, Allocator, StatsPolicy> new_data = AllocateBuffer(new_capacity);
+        StatsPolicy::OnReallocate(data_.Capacity(), new_data.Capacity());
+        ReinicializationDataIn(new_data);     
+    }
 }
 
-template <typename T>
-inline void Vector<T>::Resize(size_t new_size) {
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline void Vector<T, Allocator, GrowthPolicy, StatsPolicy>::Resize(size_t new_size) {
     if(new_size <= size_) {
          std::destroy_n(data_ + new_size, size_ - new_size); 
     } else {
@@ -457,35 +1222,370 @@ inline void Vector<T>::Resize(size_t new_size) {
     size_ = new_size;
 }
 
-template <typename T>
-inline void Vector<T>::Swap(Vector& other) {
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline void Vector<T, Allocator, GrowthPolicy, StatsPolicy>::Resize(ParallelTag policy, size_t new_size) {
+    if (new_size <= size_) {
+        Resize(new_size);
+        return;
+    }
+
+    Reserve(new_size);
+    ParallelConstructAt(policy, data_ + size_, new_size - size_, [](T* first, T* last) {
+        std::uninitialized_value_construct(first, last);
+    });
+    size_ = new_size;
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline void Vector<T, Allocator, GrowthPolicy, StatsPolicy>::ResizeDefaultInit(size_t new_size) {
+    if(new_size <= size_) {
+         std::destroy_n(data_ + new_size, size_ - new_size); 
+    } else {
+        Reserve(new_size);
+        std::uninitialized_default_construct_n(data_ + size_, new_size - size_);
+    }
+
+    size_ = new_size;
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+template <typename Operation>
+inline void Vector<T, Allocator, GrowthPolicy, StatsPolicy>::ResizeAndOverwrite(size_t count, Operation op) {
+    static_assert((std::is_trivially_default_constructible_v<T> || std::is_trivially_copyable_v<T>)
+                      && std::is_trivially_destructible_v<T>,
+                  "ResizeAndOverwrite requires a trivial or trivially copyable element type");
+
+    Reserve(count);
+    const size_t new_size = static_cast<size_t>(std::move(op)(data_.GetAddress(), count));
+
+    assert(new_size <= count);
+    size_ = new_size;
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline void Vector<T, Allocator, GrowthPolicy, StatsPolicy>::Swap(Vector& other) {
     data_.Swap(other.data_);
     std::swap(size_, other.size_);
+#ifdef ADVANCED_VECTOR_CHECKED
+    // Итераторы следуют за своими элементами
+    std::swap(iterator_state_, other.iterator_state_);
+    if (iterator_state_ != nullptr) {
+        iterator_state_->owner = this;
+    }
+    if (other.iterator_state_ != nullptr) {
+        other.iterator_state_->owner = &other;
+    }
+#endif
 }
 
-template <typename T>
-inline bool Vector<T>::Empty() {
-    return size_ == 0;
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline void Vector<T, Allocator, GrowthPolicy, StatsPolicy>::Clear() noexcept {
+    std::destroy_n(data_.GetAddress(), size_);
+    size_ = 0;
 }
 
-template <typename T>
-inline void Vector<T>::ReinicializationDataIn(RawMemory<T>& new_data) {
-    if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
-        std::uninitialized_move_n(data_.GetAddress(), size_, new_data.GetAddress());
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline void Vector<T, Allocator, GrowthPolicy, StatsPolicy>::ShrinkToFit() {
+    if (data_.Capacity() == size_) {
+        return;
+    }
+
+    if (size_ == 0) {
+        data_.Reset(data_.GetAllocator());
+        InvalidateIterators();
+        return;
+    }
+
+    if constexpr (GROWS_IN_PLACE) {
+        const size_t old_capacity = data_.Capacity();
+        data_.Reallocate(size_);
+        InvalidateIterators();
+        StatsPolicy::OnReallocate(old_capacity, data_.Capacity());
     } else {
-        std::uninitialized_copy_n(data_.GetAddress(), size_, new_data.GetAddress());
+        RawMemory<T, Allocator, StatsPolicy> new_data = AllocateBuffer(size_);
+        // Аллокатор может округлить блок до прежнего размера: тогда переносить элементы незачем
+        if (new_data.Capacity() < data_.Capacity()) {
+            StatsPolicy::OnReallocate(data_.Capacity(), new_data.Capacity());
+            ReinicializationDataIn(new_data);
+        }
     }
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline VectorBuffer<T> Vector<T, Allocator, GrowthPolicy, StatsPolicy>::Release() noexcept {
+    VectorBuffer<T> buffer{nullptr, size_, data_.Capacity()};
+    buffer.data = data_.Release();
+    InvalidateIterators();
+    size_ = 0;
+    return buffer;
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline void Vector<T, Allocator, GrowthPolicy, StatsPolicy>::Adopt(T* data, size_t size, size_t capacity) noexcept {
+    assert(size <= capacity);
 
     std::destroy_n(data_.GetAddress(), size_);
+    data_.Adopt(data, capacity);
+    InvalidateIterators();
+    size_ = data != nullptr ? size : 0;
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline void Vector<T, Allocator, GrowthPolicy, StatsPolicy>::Adopt(VectorBuffer<T> buffer) noexcept {
+    Adopt(buffer.data, buffer.size, buffer.capacity);
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline bool Vector<T, Allocator, GrowthPolicy, StatsPolicy>::Empty() {
+    return size_ == 0;
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline const Allocator& Vector<T, Allocator, GrowthPolicy, StatsPolicy>::GetAllocator() const noexcept {
+    return data_.GetAllocator();
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline size_t Vector<T, Allocator, GrowthPolicy, StatsPolicy>::NextCapacity(size_t required) const noexcept {
+    return GrowthPolicy::NextCapacity(data_.Capacity(), required, sizeof(T));
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline RawMemory<T, Allocator, StatsPolicy> Vector<T, Allocator, GrowthPolicy, StatsPolicy>::AllocateBuffer(size_t capacity) const {
+    RawMemory<T, Allocator, StatsPolicy> new_data(capacity, data_.GetAllocator());
+    StatsPolicy::OnAllocate(new_data.Capacity(), new_data.Capacity() * sizeof(T));
+
+    return new_data;
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+template <typename Construct>
+inline void Vector<T, Allocator, GrowthPolicy, StatsPolicy>::ParallelConstructAt(ParallelTag policy, T* dst, size_t count, Construct construct) {
+    ParallelConstruct(
+        policy, count, sizeof(T),
+        [dst, &construct](size_t first, size_t last) {
+            construct(dst + first, dst + last);
+        },
+        [dst](size_t first, size_t last) noexcept {
+            std::destroy(dst + first, dst + last);
+        });
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline void Vector<T, Allocator, GrowthPolicy, StatsPolicy>::GrowInPlace(size_t new_capacity) {
+    const size_t old_capacity = data_.Capacity();
+    data_.Reallocate(new_capacity);
+    InvalidateIterators();
+
+    StatsPolicy::OnAllocate(data_.Capacity(), data_.Capacity() * sizeof(T));
+    StatsPolicy::OnReallocate(old_capacity, data_.Capacity());
+    StatsPolicy::OnTransfer(TransferKind::RELOCATED, size_);
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline void Vector<T, Allocator, GrowthPolicy, StatsPolicy>::ReinicializationDataIn(RawMemory<T, Allocator, StatsPolicy>& new_data) {
+    StatsPolicy::OnTransfer(TRANSFER_KIND, size_);
+    if constexpr (IsTriviallyRelocatable<T>::value) {
+        RelocateN(data_.GetAddress(), size_, new_data.GetAddress());
+    } else {
+        if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
+            std::uninitialized_move_n(data_.GetAddress(), size_, new_data.GetAddress());
+        } else {
+            std::uninitialized_copy_n(data_.GetAddress(), size_, new_data.GetAddress());
+        }
+
+        std::destroy_n(data_.GetAddress(), size_);
+    }
     data_.Swap(new_data);
+    InvalidateIterators();
 }
 
-template <typename T>
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
 template <typename InIter, typename OutIter>
-inline void Vector<T>::ReinicializationDataIn(InIter first, InIter last, OutIter result) {
+inline void Vector<T, Allocator, GrowthPolicy, StatsPolicy>::ReinicializationDataIn(InIter first, InIter last, OutIter result) {
     if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
         std::uninitialized_move(first, last, result);
     } else {
         std::uninitialized_copy(first, last, result);
     }
 }
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline void Vector<T, Allocator, GrowthPolicy, StatsPolicy>::RelocateAroundGap(RawMemory<T, Allocator, StatsPolicy>& new_data, size_t range, size_t gap) {
+    StatsPolicy::OnTransfer(TRANSFER_KIND, size_);
+    if constexpr (IsTriviallyRelocatable<T>::value) {
+        RelocateN(data_.GetAddress(), range, new_data.GetAddress());
+        RelocateN(data_ + range, size_ - range, new_data + range + gap);
+    } else {
+        try {
+            ReinicializationDataIn(data_.GetAddress(), data_ + range, new_data.GetAddress());
+        } catch (...) {
+            std::destroy_n(new_data + range, gap);
+            throw;
+        }
+
+        try {
+            ReinicializationDataIn(data_ + range, data_ + size_, new_data + range + gap);
+        } catch (...) {
+            std::destroy_n(new_data.GetAddress(), range + gap);
+            throw;
+        }
+
+        std::destroy_n(data_.GetAddress(), size_);
+    }
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+template <typename ForwardIter>
+inline typename Vector<T, Allocator, GrowthPolicy, StatsPolicy>::iterator Vector<T, Allocator, GrowthPolicy, StatsPolicy>::InsertRange(const_iterator pos, ForwardIter first, size_t count) {
+    T* insert_position = Unwrap(pos);
+    VECTOR_CHECK(insert_position >= data_.GetAddress() && insert_position <= data_ + size_, "Insert position out of range");
+
+    const size_t range = insert_position - data_.GetAddress();
+    if (count == 0) {
+        return MakeIterator(data_ + range);
+    }
+
+    if (size_ + count > data_.Capacity()) {
+        if constexpr (GROWS_IN_PLACE) {
+            GrowInPlace(NextCapacity(size_ + count));
+        } else {
+            RawMemory<T, Allocator, StatsPolicy> new_data = AllocateBuffer(NextCapacity(size_ + count));
+            std::uninitialized_copy_n(first, count, new_data + range);
+
+            RelocateAroundGap(new_data, range, count);
+            StatsPolicy::OnReallocate(data_.Capacity(), new_data.Capacity());
+            data_.Swap(new_data);
+            InvalidateIterators();
+            size_ += count;
+
+            return MakeIterator(data_ + range);
+        }
+    }
+
+    T* position = data_ + range;
+    T* old_end = data_ + size_;
+    const size_t elements_after = size_ - range;
+    StatsPolicy::OnShift(elements_after);
+
+    if constexpr (IsTriviallyRelocatable<T>::value) {
+        RelocateN(position, elements_after, position + count);
+        try {
+            std::uninitialized_copy_n(first, count, position);
+        } catch (...) {
+            RelocateN(position + count, elements_after, position);
+            throw;
+        }
+        size_ += count;
+    } else if (elements_after > count) {
+        std::uninitialized_move(old_end - count, old_end, old_end);
+        size_ += count;
+        std::move_backward(position, old_end - count, old_end);
+        std::copy_n(first, count, position);
+    } else {
+        // Часть новых элементов ложится в неинициализированную память за концом вектора
+        ForwardIter middle = std::next(first, elements_after);
+        std::uninitialized_copy_n(middle, count - elements_after, old_end);
+        try {
+            std::uninitialized_move(position, old_end, old_end + (count - elements_after));
+        } catch (...) {
+            std::destroy_n(old_end, count - elements_after);
+            throw;
+        }
+        size_ += count;
+        std::copy(first, middle, position);
+    }
+
+    return MakeIterator(data_ + range);
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline bool Vector<T, Allocator, GrowthPolicy, StatsPolicy>::IsOwnElement(const T& value) const noexcept {
+    return !std::less<const T*>()(&value, data_.GetAddress()) && std::less<const T*>()(&value, data_ + size_);
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline typename Vector<T, Allocator, GrowthPolicy, StatsPolicy>::iterator Vector<T, Allocator, GrowthPolicy, StatsPolicy>::MakeIterator(T* position) noexcept {
+#ifdef ADVANCED_VECTOR_CHECKED
+    return iterator(position, checked_detail::AcquireState(iterator_state_, this));
+#else
+    return position;
+#endif
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline typename Vector<T, Allocator, GrowthPolicy, StatsPolicy>::const_iterator Vector<T, Allocator, GrowthPolicy, StatsPolicy>::MakeIterator(const T* position) const noexcept {
+#ifdef ADVANCED_VECTOR_CHECKED
+    return const_iterator(position, checked_detail::AcquireState(iterator_state_, this));
+#else
+    return position;
+#endif
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline T* Vector<T, Allocator, GrowthPolicy, StatsPolicy>::Unwrap(const_iterator pos) noexcept(!CHECKED_MODE) {
+#ifdef ADVANCED_VECTOR_CHECKED
+    return const_cast<T*>(pos.Unwrap(this));
+#else
+    return const_cast<T*>(pos);
+#endif
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline void Vector<T, Allocator, GrowthPolicy, StatsPolicy>::InvalidateIterators() noexcept {
+#ifdef ADVANCED_VECTOR_CHECKED
+    if (iterator_state_ != nullptr) {
+        ++iterator_state_->generation;
+    }
+#endif
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+inline void Vector<T, Allocator, GrowthPolicy, StatsPolicy>::TakeIterators([[maybe_unused]] Vector& other) noexcept {
+#ifdef ADVANCED_VECTOR_CHECKED
+    if (iterator_state_ != nullptr) {
+        iterator_state_->owner = nullptr;
+    }
+    iterator_state_ = std::move(other.iterator_state_);
+    if (iterator_state_ != nullptr) {
+        iterator_state_->owner = this;
+    }
+#endif
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy>
+template <typename InIter>
+inline void Vector<T, Allocator, GrowthPolicy, StatsPolicy>::AssignFrom(InIter first, size_t count) {
+    if (count > data_.Capacity()) {
+        RawMemory<T, Allocator, StatsPolicy> new_data = AllocateBuffer(count);
+        std::uninitialized_copy_n(first, count, new_data.GetAddress());
+
+        std::destroy_n(data_.GetAddress(), size_);
+        data_.Swap(new_data);
+        InvalidateIterators();
+    } else {
+        const size_t common = std::min(count, size_);
+        std::copy_n(first, common, data_.GetAddress());
+        
+        if(count < size_) {    
+            std::destroy_n(data_ + count, size_ - count);
+        } else {
+            std::advance(first, common);
+            std::uninitialized_copy_n(first, count - size_, data_ + size_);
+        }
+    }
+    size_ = count;
+}
+
+// Удаляет из вектора все элементы, удовлетворяющие pred, за один проход уплотнения.
+// Возвращает количество удалённых элементов
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsPolicy, typename Predicate>
+inline size_t EraseIf(Vector<T, Allocator, GrowthPolicy, StatsPolicy>& vector, Predicate pred) {
+    auto new_end = std::remove_if(vector.begin(), vector.end(), pred);
+    const size_t removed = vector.end() - new_end;
+    vector.Erase(new_end, vector.end());
+
+    return removed;
+}
+
+#undef VECTOR_CHECK
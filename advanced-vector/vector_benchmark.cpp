@@ -0,0 +1,357 @@
+#include "traversal.h"
+#include "vector.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// Тривиально копируемая запись: Vector переносит её через memmove
+struct Trivial {
+    int64_t key = 0;
+    double value = 0.0;
+};
+
+// Владеет памятью в куче, перемещение дешёвое и noexcept
+struct HeavyMove {
+    std::string name;
+    std::vector<int> payload;
+};
+
+// Перемещение не помечено noexcept, поэтому при росте элементы копируются
+struct ThrowingCopy {
+    ThrowingCopy() = default;
+    explicit ThrowingCopy(std::string name) : name(std::move(name)) {
+    }
+    ThrowingCopy(const ThrowingCopy&) = default;
+    ThrowingCopy(ThrowingCopy&& other) : name(std::move(other.name)) {
+    }
+    ThrowingCopy& operator=(const ThrowingCopy&) = default;
+    ThrowingCopy& operator=(ThrowingCopy&& other) {
+        name = std::move(other.name);
+        return *this;
+    }
+
+    std::string name;
+};
+
+template <typename T>
+T MakeValue(size_t i);
+
+template <>
+Trivial MakeValue<Trivial>(size_t i) {
+    return {static_cast<int64_t>(i), static_cast<double>(i)};
+}
+
+template <>
+HeavyMove MakeValue<HeavyMove>(size_t i) {
+    return {std::string(32, static_cast<char>('a' + i % 26)), std::vector<int>(4, static_cast<int>(i))};
+}
+
+template <>
+ThrowingCopy MakeValue<ThrowingCopy>(size_t i) {
+    return ThrowingCopy(std::string(32, static_cast<char>('a' + i % 26)));
+}
+
+// Единый интерфейс для сравнения Vector и std::vector в одних и тех же бенчмарках
+template <typename T>
+void PushBack(Vector<T>& v, const T& value) {
+    v.PushBack(value);
+}
+
+template <typename T>
+void PushBack(std::vector<T>& v, const T& value) {
+    v.push_back(value);
+}
+
+template <typename T>
+void EmplaceBack(Vector<T>& v, T&& value) {
+    v.EmplaceBack(std::move(value));
+}
+
+template <typename T>
+void EmplaceBack(std::vector<T>& v, T&& value) {
+    v.emplace_back(std::move(value));
+}
+
+// Для std::vector пакетное добавление - это reserve и цикл emplace_back
+template <typename T>
+void AppendGenerated(Vector<T>& v, size_t count) {
+    v.AppendBatch(count, [](size_t i) {
+        return MakeValue<T>(i);
+    });
+}
+
+template <typename T>
+void AppendGenerated(std::vector<T>& v, size_t count) {
+    v.reserve(v.size() + count);
+    for (size_t i = 0; i < count; ++i) {
+        v.emplace_back(MakeValue<T>(i));
+    }
+}
+
+template <typename T>
+void InsertAt(Vector<T>& v, size_t index, const T& value) {
+    v.Insert(v.begin() + index, value);
+}
+
+template <typename T>
+void InsertAt(std::vector<T>& v, size_t index, const T& value) {
+    v.insert(v.begin() + index, value);
+}
+
+template <typename T>
+void EraseAt(Vector<T>& v, size_t index) {
+    v.Erase(v.begin() + index);
+}
+
+template <typename T>
+void EraseAt(std::vector<T>& v, size_t index) {
+    v.erase(v.begin() + index);
+}
+
+template <typename T>
+void PopBack(Vector<T>& v) {
+    v.PopBack();
+}
+
+template <typename T>
+void PopBack(std::vector<T>& v) {
+    v.pop_back();
+}
+
+template <typename T>
+void Reserve(Vector<T>& v, size_t capacity) {
+    v.Reserve(capacity);
+}
+
+template <typename T>
+void Reserve(std::vector<T>& v, size_t capacity) {
+    v.reserve(capacity);
+}
+
+template <typename Container>
+Container MakeContainer(size_t size) {
+    using T = typename Container::value_type;
+    Container v;
+    Reserve(v, size);
+    for (size_t i = 0; i < size; ++i) {
+        PushBack(v, MakeValue<T>(i));
+    }
+    return v;
+}
+
+template <typename Container>
+void BM_PushBack(benchmark::State& state) {
+    using T = typename Container::value_type;
+    const size_t size = static_cast<size_t>(state.range(0));
+    const T value = MakeValue<T>(size);
+
+    for (auto _ : state) {
+        Container v;
+        for (size_t i = 0; i < size; ++i) {
+            PushBack(v, value);
+        }
+        benchmark::DoNotOptimize(v);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(size));
+}
+
+template <typename Container>
+void BM_EmplaceBack(benchmark::State& state) {
+    using T = typename Container::value_type;
+    const size_t size = static_cast<size_t>(state.range(0));
+
+    for (auto _ : state) {
+        Container v;
+        for (size_t i = 0; i < size; ++i) {
+            EmplaceBack(v, MakeValue<T>(i));
+        }
+        benchmark::DoNotOptimize(v);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(size));
+}
+
+template <typename Container>
+void BM_AppendBatch(benchmark::State& state) {
+    const size_t size = static_cast<size_t>(state.range(0));
+
+    for (auto _ : state) {
+        Container v;
+        AppendGenerated(v, size);
+        benchmark::DoNotOptimize(v);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(size));
+}
+
+// Вставка в вектор размера n; PopBack за O(1) возвращает размер к исходному
+template <typename Container>
+void InsertBenchmark(benchmark::State& state, size_t index) {
+    using T = typename Container::value_type;
+    const size_t size = static_cast<size_t>(state.range(0));
+    Container v = MakeContainer<Container>(size);
+    Reserve(v, size + 1);
+    const T value = MakeValue<T>(0);
+
+    for (auto _ : state) {
+        InsertAt(v, index, value);
+        PopBack(v);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+template <typename Container>
+void BM_InsertFront(benchmark::State& state) {
+    InsertBenchmark<Container>(state, 0);
+}
+
+template <typename Container>
+void BM_InsertMiddle(benchmark::State& state) {
+    InsertBenchmark<Container>(state, static_cast<size_t>(state.range(0)) / 2);
+}
+
+// Удаление из середины вектора размера n; PushBack за O(1) возвращает размер к исходному
+template <typename Container>
+void BM_EraseMiddle(benchmark::State& state) {
+    using T = typename Container::value_type;
+    const size_t size = static_cast<size_t>(state.range(0));
+    Container v = MakeContainer<Container>(size);
+    const T value = MakeValue<T>(0);
+
+    for (auto _ : state) {
+        EraseAt(v, size / 2);
+        PushBack(v, value);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+template <typename Container>
+void BM_Reserve(benchmark::State& state) {
+    const size_t size = static_cast<size_t>(state.range(0));
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        Container v = MakeContainer<Container>(size);
+        state.ResumeTiming();
+
+        Reserve(v, size * 2);
+        benchmark::DoNotOptimize(v);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(size));
+}
+
+template <typename Container>
+void BM_CopyAssign(benchmark::State& state) {
+    const size_t size = static_cast<size_t>(state.range(0));
+    const Container source = MakeContainer<Container>(size);
+    Container target;
+
+    for (auto _ : state) {
+        target = source;
+        benchmark::DoNotOptimize(target);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(size));
+}
+
+template <typename Container>
+void BM_MoveAssign(benchmark::State& state) {
+    const size_t size = static_cast<size_t>(state.range(0));
+    Container first = MakeContainer<Container>(size);
+    Container second;
+
+    for (auto _ : state) {
+        second = std::move(first);
+        first = std::move(second);
+        benchmark::DoNotOptimize(first);
+    }
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+
+template <typename Container>
+void BM_Iterate(benchmark::State& state) {
+    using T = typename Container::value_type;
+    const size_t size = static_cast<size_t>(state.range(0));
+    const Container v = MakeContainer<Container>(size);
+
+    for (auto _ : state) {
+        for (const T& value : v) {
+            benchmark::DoNotOptimize(&value);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(size));
+}
+
+// Узел размером в строку кэша: при обходе указателей каждое обращение - отдельный промах
+struct alignas(64) Node {
+    int64_t key = 0;
+};
+
+// Косвенный обход перемешанных указателей на узлы, не помещающиеся в кэш.
+// Аргумент - дистанция предвыборки, 0 означает обход без подсказок
+void BM_IndirectScan(benchmark::State& state) {
+    constexpr size_t size = size_t{1} << 20;
+    const size_t distance = static_cast<size_t>(state.range(0));
+
+    Vector<Node> nodes(size);
+    Vector<const Node*> pointers;
+    pointers.Reserve(size);
+    for (size_t i = 0; i < size; ++i) {
+        nodes[i].key = static_cast<int64_t>(i);
+        pointers.PushBack(&nodes[i]);
+    }
+    std::shuffle(pointers.AsSpan().begin(), pointers.AsSpan().end(), std::mt19937_64(42));
+
+    for (auto _ : state) {
+        int64_t sum = 0;
+        ForEachPrefetched(pointers, distance, [&sum](const Node* node) {
+            sum += node->key;
+        });
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(size));
+}
+
+// Тривиальные записи проверяются до 10^8 элементов, типы с памятью в куче до 10^6
+constexpr int64_t MAX_TRIVIAL_SIZE = 100'000'000;
+constexpr int64_t MAX_HEAVY_SIZE = 1'000'000;
+
+void TrivialSizes(benchmark::internal::Benchmark* bench) {
+    bench->RangeMultiplier(10)->Range(1, MAX_TRIVIAL_SIZE);
+}
+
+void HeavySizes(benchmark::internal::Benchmark* bench) {
+    bench->RangeMultiplier(10)->Range(1, MAX_HEAVY_SIZE);
+}
+
+}  // namespace
+
+#define VECTOR_BENCHMARK(name, type, sizes)                                        \
+    BENCHMARK_TEMPLATE(name, Vector<type>)->Apply(sizes);                         \
+    BENCHMARK_TEMPLATE(name, std::vector<type>)->Apply(sizes)
+
+#define VECTOR_BENCHMARK_ALL_TYPES(name)                                           \
+    VECTOR_BENCHMARK(name, Trivial, TrivialSizes);                                 \
+    VECTOR_BENCHMARK(name, HeavyMove, HeavySizes);                                 \
+    VECTOR_BENCHMARK(name, ThrowingCopy, HeavySizes)
+
+VECTOR_BENCHMARK_ALL_TYPES(BM_PushBack);
+VECTOR_BENCHMARK_ALL_TYPES(BM_EmplaceBack);
+VECTOR_BENCHMARK_ALL_TYPES(BM_AppendBatch);
+VECTOR_BENCHMARK_ALL_TYPES(BM_InsertFront);
+VECTOR_BENCHMARK_ALL_TYPES(BM_InsertMiddle);
+VECTOR_BENCHMARK_ALL_TYPES(BM_EraseMiddle);
+VECTOR_BENCHMARK_ALL_TYPES(BM_Reserve);
+VECTOR_BENCHMARK_ALL_TYPES(BM_CopyAssign);
+VECTOR_BENCHMARK_ALL_TYPES(BM_MoveAssign);
+VECTOR_BENCHMARK_ALL_TYPES(BM_Iterate);
+BENCHMARK(BM_IndirectScan)->Arg(0)->Arg(4)->Arg(16)->Arg(64);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,471 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+#include <typeinfo>
+
+// Политика статистики получает события Vector через статические функции,
+// поэтому не увеличивает размер вектора. NoVectorStats не делает ничего и
+// полностью исчезает после оптимизации
+
+// Способ, которым элементы переезжают в новый буфер при росте
+enum class TransferKind {
+    RELOCATED,  // побайтово, через memmove или realloc
+    MOVED,
+    COPIED,     // конструктор перемещения не noexcept
+};
+
+struct VectorStats {
+    size_t reallocations = 0;
+    size_t bytes_allocated = 0;
+    size_t elements_relocated = 0;
+    size_t elements_moved = 0;
+    size_t elements_copied = 0;
+    size_t elements_shifted = 0;
+    size_t peak_capacity = 0;
+};
+
+struct NoVectorStats {
+    // Выделен новый буфер под capacity элементов
+    static void OnAllocate(size_t /*capacity*/, size_t /*bytes*/) noexcept {
+    }
+
+    // Вектор вырос из буфера old_capacity в буфер new_capacity. old_capacity == 0
+    // означает первое выделение памяти пустым вектором
+    static void OnReallocate(size_t /*old_capacity*/, size_t /*new_capacity*/) noexcept {
+    }
+
+    // count элементов перенесены в новый буфер способом kind
+    static void OnTransfer(TransferKind /*kind*/, size_t /*count*/) noexcept {
+    }
+
+    // count элементов сдвинуты внутри буфера при вставке или удалении
+    static void OnShift(size_t /*count*/) noexcept {
+    }
+};
+
+// Политика может дополнительно учитывать занятую память. Тогда о каждом буфере ей сообщает
+// RawMemory, а о каждом изменении размера - Vector:
+//   static void OnBufferAcquire(size_t bytes) noexcept;     // вектор завёл буфер
+//   static void OnBufferRelease(size_t bytes) noexcept;     // буфер освобождён или отдан через Release
+//   static void OnUsedBytes(std::ptrdiff_t delta) noexcept;  // изменилось Size() * sizeof(T)
+// Без этих функций размер вектора хранится обычным size_t и учёт ничего не стоит
+template <typename StatsPolicy, typename = void>
+struct HasMemoryAccounting : std::false_type {};
+
+template <typename StatsPolicy>
+struct HasMemoryAccounting<StatsPolicy, std::void_t<decltype(StatsPolicy::OnBufferAcquire(size_t{}))>>
+    : std::true_type {};
+
+// Размер вектора, сообщающий политике о байтах, занятых элементами. Каждый живой счётчик
+// учтён ровно своим значением, поэтому сумма верна и после перемещений, обменов и временных копий
+template <typename StatsPolicy, typename T>
+class AccountedSize {
+public:
+    AccountedSize() noexcept = default;
+    AccountedSize(size_t size) noexcept;
+    AccountedSize(const AccountedSize& other) noexcept;
+    ~AccountedSize();
+
+    AccountedSize& operator=(const AccountedSize& other) noexcept;
+    AccountedSize& operator=(size_t size) noexcept;
+
+    AccountedSize& operator++() noexcept;
+    AccountedSize& operator--() noexcept;
+    AccountedSize& operator+=(size_t count) noexcept;
+    AccountedSize& operator-=(size_t count) noexcept;
+
+    operator size_t() const noexcept;
+
+private:
+    size_t size_ = 0;
+
+    static void Report(std::ptrdiff_t elements) noexcept;
+};
+
+// Сводка по памяти векторов одного Tag. Счётчики событий растут монотонно: частота
+// выделений и реаллокаций - это разность двух отчётов, делённая на интервал между ними
+struct VectorMemoryReport {
+    const char* name = "";
+    size_t live_buffers = 0;
+    size_t live_bytes = 0;       // ёмкость всех живых буферов
+    size_t used_bytes = 0;       // занято элементами, Size() * sizeof(T)
+    size_t slack_bytes = 0;      // live_bytes - used_bytes
+    size_t peak_live_bytes = 0;
+    size_t allocations = 0;
+    size_t reallocations = 0;
+};
+
+namespace stats_detail {
+
+// Звено глобального списка Tag, по которым ведётся учёт памяти. Звенья статические и
+// добавляются без блокировок при первом выделении памяти, поэтому их не нужно удалять
+struct AccountingNode {
+    using Report = VectorMemoryReport (*)() noexcept;
+
+    constexpr explicit AccountingNode(Report report) noexcept : report(report) {
+    }
+
+    const Report report;
+    AccountingNode* next = nullptr;
+    std::atomic<bool> registered{false};
+};
+
+inline std::atomic<AccountingNode*> accounting_head{nullptr};
+
+inline void Register(AccountingNode& node) noexcept {
+    if (node.registered.exchange(true, std::memory_order_relaxed)) {
+        return;
+    }
+
+    AccountingNode* head = accounting_head.load(std::memory_order_relaxed);
+    do {
+        node.next = head;
+    } while (!accounting_head.compare_exchange_weak(head, &node, std::memory_order_release, std::memory_order_relaxed));
+}
+
+template <typename Tag, typename = void>
+struct HasTagName : std::false_type {};
+
+template <typename Tag>
+struct HasTagName<Tag, std::void_t<decltype(Tag::NAME)>> : std::true_type {};
+
+template <typename Tag>
+const char* TagName() noexcept {
+    if constexpr (HasTagName<Tag>::value) {
+        return Tag::NAME;
+    } else {
+        return typeid(Tag).name();
+    }
+}
+
+}  // namespace stats_detail
+
+// Учитывает живые буферы, занятые и свободные байты всех векторов с одним Tag. Имя в отчёте
+// берётся из Tag::NAME, если оно есть. Каждое изменение размера - атомарная операция
+// над общим счётчиком, поэтому политику стоит применять к векторам, которые важно измерить
+template <typename Tag = void>
+class AccountingVectorStats {
+public:
+    static void OnAllocate(size_t capacity, size_t bytes) noexcept;
+    static void OnReallocate(size_t old_capacity, size_t new_capacity) noexcept;
+    static void OnTransfer(TransferKind kind, size_t count) noexcept;
+    static void OnShift(size_t count) noexcept;
+
+    static void OnBufferAcquire(size_t bytes) noexcept;
+    static void OnBufferRelease(size_t bytes) noexcept;
+    static void OnUsedBytes(std::ptrdiff_t delta) noexcept;
+
+    static VectorMemoryReport Get() noexcept;
+
+private:
+    static inline std::atomic<size_t> live_buffers_{0};
+    static inline std::atomic<size_t> live_bytes_{0};
+    static inline std::atomic<std::ptrdiff_t> used_bytes_{0};
+    static inline std::atomic<size_t> peak_live_bytes_{0};
+    static inline std::atomic<size_t> allocations_{0};
+    static inline std::atomic<size_t> reallocations_{0};
+
+    static inline stats_detail::AccountingNode node_{&Get};
+};
+
+// Вызывает callback(const VectorMemoryReport&) для каждого Tag с AccountingVectorStats,
+// векторы которого хотя бы раз выделяли память. Подходит для периодической выгрузки метрик
+template <typename Callback>
+void ForEachVectorMemoryReport(Callback callback);
+
+// Накапливает статистику всех векторов с одним и тем же Tag. Отдельный Tag на место
+// вызова позволяет найти, где вектор многократно растёт или копирует элементы
+template <typename Tag = void>
+class CountingVectorStats {
+public:
+    static void OnAllocate(size_t capacity, size_t bytes) noexcept;
+    static void OnReallocate(size_t old_capacity, size_t new_capacity) noexcept;
+    static void OnTransfer(TransferKind kind, size_t count) noexcept;
+    static void OnShift(size_t count) noexcept;
+
+    static VectorStats Get() noexcept;
+    static void Reset() noexcept;
+
+private:
+    static inline std::atomic<size_t> reallocations_{0};
+    static inline std::atomic<size_t> bytes_allocated_{0};
+    static inline std::atomic<size_t> elements_relocated_{0};
+    static inline std::atomic<size_t> elements_moved_{0};
+    static inline std::atomic<size_t> elements_copied_{0};
+    static inline std::atomic<size_t> elements_shifted_{0};
+    static inline std::atomic<size_t> peak_capacity_{0};
+};
+
+enum class VectorEventKind {
+    ALLOCATE,
+    REALLOCATE,
+    TRANSFER,
+    SHIFT,
+};
+
+struct VectorEvent {
+    VectorEventKind kind;
+    TransferKind transfer = TransferKind::RELOCATED;
+    size_t count = 0;         // элементов перенесено или сдвинуто; ёмкость нового буфера
+    size_t old_capacity = 0;  // только для REALLOCATE
+    size_t bytes = 0;         // только для ALLOCATE
+};
+
+// Передаёт каждое событие векторов с данным Tag в установленный обработчик
+template <typename Tag = void>
+class CallbackVectorStats {
+public:
+    using Callback = void (*)(const VectorEvent& event);
+
+    static void SetCallback(Callback callback) noexcept;
+
+    static void OnAllocate(size_t capacity, size_t bytes) noexcept;
+    static void OnReallocate(size_t old_capacity, size_t new_capacity) noexcept;
+    static void OnTransfer(TransferKind kind, size_t count) noexcept;
+    static void OnShift(size_t count) noexcept;
+
+private:
+    static inline std::atomic<Callback> callback_{nullptr};
+
+    static void Notify(const VectorEvent& event) noexcept;
+};
+
+//-------------------------COUNTING_VECTOR_STATS---------------------
+template <typename Tag>
+inline void CountingVectorStats<Tag>::OnAllocate(size_t capacity, size_t bytes) noexcept {
+    bytes_allocated_.fetch_add(bytes, std::memory_order_relaxed);
+
+    size_t peak = peak_capacity_.load(std::memory_order_relaxed);
+    while (peak < capacity && !peak_capacity_.compare_exchange_weak(peak, capacity, std::memory_order_relaxed)) {
+    }
+}
+
+template <typename Tag>
+inline void CountingVectorStats<Tag>::OnReallocate(size_t old_capacity, size_t /*new_capacity*/) noexcept {
+    if (old_capacity != 0) {
+        reallocations_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+template <typename Tag>
+inline void CountingVectorStats<Tag>::OnTransfer(TransferKind kind, size_t count) noexcept {
+    switch (kind) {
+    case TransferKind::RELOCATED:
+        elements_relocated_.fetch_add(count, std::memory_order_relaxed);
+        break;
+    case TransferKind::MOVED:
+        elements_moved_.fetch_add(count, std::memory_order_relaxed);
+        break;
+    case TransferKind::COPIED:
+        elements_copied_.fetch_add(count, std::memory_order_relaxed);
+        break;
+    }
+}
+
+template <typename Tag>
+inline void CountingVectorStats<Tag>::OnShift(size_t count) noexcept {
+    elements_shifted_.fetch_add(count, std::memory_order_relaxed);
+}
+
+template <typename Tag>
+inline VectorStats CountingVectorStats<Tag>::Get() noexcept {
+    VectorStats stats;
+    stats.reallocations = reallocations_.load(std::memory_order_relaxed);
+    stats.bytes_allocated = bytes_allocated_.load(std::memory_order_relaxed);
+    stats.elements_relocated = elements_relocated_.load(std::memory_order_relaxed);
+    stats.elements_moved = elements_moved_.load(std::memory_order_relaxed);
+    stats.elements_copied = elements_copied_.load(std::memory_order_relaxed);
+    stats.elements_shifted = elements_shifted_.load(std::memory_order_relaxed);
+    stats.peak_capacity = peak_capacity_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+template <typename Tag>
+inline void CountingVectorStats<Tag>::Reset() noexcept {
+    reallocations_.store(0, std::memory_order_relaxed);
+    bytes_allocated_.store(0, std::memory_order_relaxed);
+    elements_relocated_.store(0, std::memory_order_relaxed);
+    elements_moved_.store(0, std::memory_order_relaxed);
+    elements_copied_.store(0, std::memory_order_relaxed);
+    elements_shifted_.store(0, std::memory_order_relaxed);
+    peak_capacity_.store(0, std::memory_order_relaxed);
+}
+
+//-------------------------ACCOUNTED_SIZE---------------------
+template <typename StatsPolicy, typename T>
+inline AccountedSize<StatsPolicy, T>::AccountedSize(size_t size) noexcept : size_(size) {
+    Report(static_cast<std::ptrdiff_t>(size));
+}
+
+template <typename StatsPolicy, typename T>
+inline AccountedSize<StatsPolicy, T>::AccountedSize(const AccountedSize& other) noexcept : AccountedSize(other.size_) {
+}
+
+template <typename StatsPolicy, typename T>
+inline AccountedSize<StatsPolicy, T>::~AccountedSize() {
+    Report(-static_cast<std::ptrdiff_t>(size_));
+}
+
+template <typename StatsPolicy, typename T>
+inline AccountedSize<StatsPolicy, T>& AccountedSize<StatsPolicy, T>::operator=(const AccountedSize& other) noexcept {
+    return *this = other.size_;
+}
+
+template <typename StatsPolicy, typename T>
+inline AccountedSize<StatsPolicy, T>& AccountedSize<StatsPolicy, T>::operator=(size_t size) noexcept {
+    Report(static_cast<std::ptrdiff_t>(size) - static_cast<std::ptrdiff_t>(size_));
+    size_ = size;
+    return *this;
+}
+
+template <typename StatsPolicy, typename T>
+inline AccountedSize<StatsPolicy, T>& AccountedSize<StatsPolicy, T>::operator++() noexcept {
+    return *this += 1;
+}
+
+template <typename StatsPolicy, typename T>
+inline AccountedSize<StatsPolicy, T>& AccountedSize<StatsPolicy, T>::operator--() noexcept {
+    return *this -= 1;
+}
+
+template <typename StatsPolicy, typename T>
+inline AccountedSize<StatsPolicy, T>& AccountedSize<StatsPolicy, T>::operator+=(size_t count) noexcept {
+    Report(static_cast<std::ptrdiff_t>(count));
+    size_ += count;
+    return *this;
+}
+
+template <typename StatsPolicy, typename T>
+inline AccountedSize<StatsPolicy, T>& AccountedSize<StatsPolicy, T>::operator-=(size_t count) noexcept {
+    Report(-static_cast<std::ptrdiff_t>(count));
+    size_ -= count;
+    return *this;
+}
+
+template <typename StatsPolicy, typename T>
+inline AccountedSize<StatsPolicy, T>::operator size_t() const noexcept {
+    return size_;
+}
+
+template <typename StatsPolicy, typename T>
+inline void AccountedSize<StatsPolicy, T>::Report(std::ptrdiff_t elements) noexcept {
+    if (elements != 0) {
+        StatsPolicy::OnUsedBytes(elements * static_cast<std::ptrdiff_t>(sizeof(T)));
+    }
+}
+
+//-------------------------ACCOUNTING_VECTOR_STATS---------------------
+template <typename Tag>
+inline void AccountingVectorStats<Tag>::OnAllocate(size_t /*capacity*/, size_t /*bytes*/) noexcept {
+    allocations_.fetch_add(1, std::memory_order_relaxed);
+}
+
+template <typename Tag>
+inline void AccountingVectorStats<Tag>::OnReallocate(size_t old_capacity, size_t /*new_capacity*/) noexcept {
+    if (old_capacity != 0) {
+        reallocations_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+template <typename Tag>
+inline void AccountingVectorStats<Tag>::OnTransfer(TransferKind /*kind*/, size_t /*count*/) noexcept {
+}
+
+template <typename Tag>
+inline void AccountingVectorStats<Tag>::OnShift(size_t /*count*/) noexcept {
+}
+
+template <typename Tag>
+inline void AccountingVectorStats<Tag>::OnBufferAcquire(size_t bytes) noexcept {
+    if (!node_.registered.load(std::memory_order_relaxed)) {
+        stats_detail::Register(node_);
+    }
+
+    live_buffers_.fetch_add(1, std::memory_order_relaxed);
+    const size_t live = live_bytes_.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+
+    size_t peak = peak_live_bytes_.load(std::memory_order_relaxed);
+    while (peak < live && !peak_live_bytes_.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+    }
+}
+
+template <typename Tag>
+inline void AccountingVectorStats<Tag>::OnBufferRelease(size_t bytes) noexcept {
+    live_buffers_.fetch_sub(1, std::memory_order_relaxed);
+    live_bytes_.fetch_sub(bytes, std::memory_order_relaxed);
+}
+
+template <typename Tag>
+inline void AccountingVectorStats<Tag>::OnUsedBytes(std::ptrdiff_t delta) noexcept {
+    used_bytes_.fetch_add(delta, std::memory_order_relaxed);
+}
+
+template <typename Tag>
+inline VectorMemoryReport AccountingVectorStats<Tag>::Get() noexcept {
+    VectorMemoryReport report;
+    report.name = stats_detail::TagName<Tag>();
+    report.live_buffers = live_buffers_.load(std::memory_order_relaxed);
+    report.live_bytes = live_bytes_.load(std::memory_order_relaxed);
+    // Счётчики читаются не одновременно, поэтому под нагрузкой занятые байты
+    // могут ненадолго превысить ёмкость
+    const std::ptrdiff_t used = used_bytes_.load(std::memory_order_relaxed);
+    report.used_bytes = used > 0 ? static_cast<size_t>(used) : 0;
+    report.slack_bytes = report.live_bytes > report.used_bytes ? report.live_bytes - report.used_bytes : 0;
+    report.peak_live_bytes = peak_live_bytes_.load(std::memory_order_relaxed);
+    report.allocations = allocations_.load(std::memory_order_relaxed);
+    report.reallocations = reallocations_.load(std::memory_order_relaxed);
+    return report;
+}
+
+template <typename Callback>
+inline void ForEachVectorMemoryReport(Callback callback) {
+    for (auto* node = stats_detail::accounting_head.load(std::memory_order_acquire); node != nullptr; node = node->next) {
+        callback(node->report());
+    }
+}
+
+//-------------------------CALLBACK_VECTOR_STATS---------------------
+template <typename Tag>
+inline void CallbackVectorStats<Tag>::SetCallback(Callback callback) noexcept {
+    callback_.store(callback, std::memory_order_release);
+}
+
+template <typename Tag>
+inline void CallbackVectorStats<Tag>::OnAllocate(size_t capacity, size_t bytes) noexcept {
+    VectorEvent event{VectorEventKind::ALLOCATE};
+    event.count = capacity;
+    event.bytes = bytes;
+    Notify(event);
+}
+
+template <typename Tag>
+inline void CallbackVectorStats<Tag>::OnReallocate(size_t old_capacity, size_t new_capacity) noexcept {
+    VectorEvent event{VectorEventKind::REALLOCATE};
+    event.count = new_capacity;
+    event.old_capacity = old_capacity;
+    Notify(event);
+}
+
+template <typename Tag>
+inline void CallbackVectorStats<Tag>::OnTransfer(TransferKind kind, size_t count) noexcept {
+    VectorEvent event{VectorEventKind::TRANSFER};
+    event.transfer = kind;
+    event.count = count;
+    Notify(event);
+}
+
+template <typename Tag>
+inline void CallbackVectorStats<Tag>::OnShift(size_t count) noexcept {
+    VectorEvent event{VectorEventKind::SHIFT};
+    event.count = count;
+    Notify(event);
+}
+
+template <typename Tag>
+inline void CallbackVectorStats<Tag>::Notify(const VectorEvent& event) noexcept {
+    if (Callback callback = callback_.load(std::memory_order_acquire)) {
+        callback(event);
+    }
+}